@@ -1,133 +1,445 @@
 /**
  * @file Dataset.h
- * 
- * Clase concreta donde se almacena la información. Se trata de un vector de
- * vectores y varias funciones auxiliares para añadir y extraer información de
- * este.
- * 
+ *
+ * Clase concreta donde se almacena la información. Todas las filas se guardan
+ * seguidas en un único vector de valores (formato CSR). Mientras todas las
+ * filas tienen el mismo tamaño (puntos, tetraedros, triángulos...) la posición
+ * de cada fila se calcula a partir de ese tamaño. Cuando aparece una fila de
+ * otro tamaño se pasa a guardar también donde comienza cada fila.
+ *
+ * Los vectores reservan su memoria del recurso indicado al crearlos, que
+ * normalmente es la arena de su DatasetContext. La arena no reutiliza la
+ * memoria que libera un vector al crecer, así que las filas que se vayan a
+ * añadir deben reservarse antes, al crearlo o con reserve().
+ *
+ * Si el tamaño de las filas se conoce al compilar (parámetro N) no se guarda
+ * ninguna información por fila y los bucles sobre una fila tienen un número
+ * de iteraciones fijo. Estas especializaciones solo admiten filas de tamaño N.
+ *
  * @tparam T    El tipo de datos que almacenará el vector.
- * 
+ * @tparam N    Número de valores de cada fila, 0 si es variable.
+ *
  * @author  Víctor Guillermo Andrés Escudero
  * @date    01/08/2018
  * @version 1.0
- * 
+ *
  **/
 
 #ifndef DATASETDOUBLE_H
 #define DATASETDOUBLE_H
 
 #include "DatasetAbstract.h"
+#include "RowView.h"
 #include <string>
 #include <vector>
+#include <memory_resource>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
 #include <iostream>
 
-template <typename T>
+template <typename T, unsigned int N = 0>
 class Dataset : public DatasetAbstract{
 public:
     typedef T value_type; ///< Variable que contine el tipo de dato usado.
-    
+
+    /// Tipo en el que se guardan los valores. Los bool se guardan como
+    /// unsigned char para que las filas sean contiguas.
+    typedef typename std::conditional<std::is_same<T, bool>::value, unsigned char, T>::type stored_type;
+
     /**
      * Constructor. Llama al constructor de la clase de la que hereda para
-     * añadir el nuevo conj. de datos a la tabla hash. También reserva en el
-     * vector espacio suficiente para la cantidad de elementos que se le indique.
+     * añadir el nuevo conj. de datos a la tabla hash. La cantidad de filas a
+     * reservar se recuerda hasta conocer el tamaño de la primera fila.
      * No debe de ser llamado por si solo, en su lugar este constructor se llamará
      * a traves del método factoría de su clase padre.
-     * 
-     * @param [in]  size    Número de elementos a reservar en el vector. 0 por defecto.
+     *
+     * @param [in]  size        Número de filas a reservar. 0 por defecto.
+     * @param [in]  resource    Recurso del que se reserva la memoria de los
+     *                          valores. El del sistema por defecto.
      **/
-    Dataset(const std::string& name, unsigned int size = 0) : DatasetAbstract(name, size) {
-        if (size > 0){
-            this->data.reserve(size);
-        }
+    Dataset(const std::string& name, unsigned int size = 0,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : DatasetAbstract(name, size), data(resource), offsets(resource) {
+        this->reserved_rows = size;
+        this->rows = 0;
+        this->stride = N;
+        this->is_fixed = true;
+
+        if (N > 0 && size > 0)
+            this->data.reserve(size * N);
     }
-    
-    
+
     /**
-     * Añade al final del vector el array suministrado.
-     * 
+     * Constructor que adopta los valores de otro conj. de datos cuyas filas
+     * tienen todas N valores. Lo usa createFixedArity(). Los valores siguen
+     * en el mismo recurso de memoria.
+     *
+     * @param [in]  name    Nombre del conj. de datos.
+     * @param [in]  values  Valores de todas las filas.
+     **/
+    Dataset(const std::string& name, std::pmr::vector<stored_type>&& values)
+        : DatasetAbstract(name, 0), data(std::move(values)), offsets(data.get_allocator()) {
+        static_assert(N > 0, "Solo las filas de tamaño fijo pueden adoptar valores");
+        this->reserved_rows = 0;
+        this->rows = this->data.size() / N;
+        this->stride = N;
+        this->is_fixed = true;
+    }
+
+
+    /**
+     * Añade al final la fila suministrada.
+     *
      * @param [in]  data    Puntero al array.
      * @param [in]  size    Tamaño del array.
      **/
     void addData (const double data[], unsigned int size) {
-        std::vector<T> data_new;
-
-        for (int i = 0; i < size; ++i) {
-            data_new.push_back(data[i]);
-        }
-        this->data.push_back(data_new);
+        if (!prepareRow(size))
+            return;
+        this->data.insert(this->data.end(), data, data + size);
     }
-    
+
     /**
-     * Añade al final del vector el vector suministrado.
-     * 
+     * Añade al final la fila suministrada.
+     *
      * @param [in]  data    Vector a añadir.
-     **/    
+     **/
     void addData (const std::vector<double>& data) {
-        std::vector<T> aux (data.begin(), data.end());
-        this->data.push_back(aux);
+        addData(data.data(), data.size());
+    }
+
+    /**
+     * Añade al final varias filas a partir de un array contiguo cuyos valores
+     * ya son del tipo T, sin pasar por double. Si todas las filas tienen el
+     * mismo tamaño que las anteriores se copian de una vez. Si el tamaño de
+     * los valores no coincide con el de T no se añade nada.
+     *
+     * @param [in]  data        Puntero al array, con rows * row_size valores.
+     * @param [in]  value_size  Tamaño en bytes de cada valor del array.
+     * @param [in]  rows        Número de filas a añadir.
+     * @param [in]  row_size    Número de valores de cada fila.
+     * @return true si se han añadido las filas, false en caso contrario.
+     **/
+    bool addRawData (const void* data, size_t value_size, size_t rows, unsigned int row_size) {
+        if (value_size != sizeof(T) || (N > 0 && row_size != N))
+            return false;
+
+        const stored_type* values = static_cast<const stored_type*>(data);
+
+        if (is_fixed && (this->rows == 0 || stride == row_size)) {
+            if (this->rows == 0 && reserved_rows > 0)
+                this->data.reserve(reserved_rows * row_size);
+            stride = row_size;
+            this->data.insert(this->data.end(), values, values + rows * row_size);
+            this->rows += rows;
+            return true;
+        }
+
+        for (size_t i = 0; i < rows; ++i) {
+            prepareRow(row_size);
+            this->data.insert(this->data.end(), values + i * row_size, values + (i + 1) * row_size);
+        }
+        return true;
     }
-    
+
+    /**
+     * Añade al final varias filas con sus valores a 0 y devuelve un puntero a
+     * ellos, para rellenarlos directamente en el tipo T sin copias
+     * intermedias. Solo es posible si las filas tienen el mismo tamaño que
+     * las anteriores.
+     *
+     * @param [in]  value_size  Tamaño en bytes de cada valor.
+     * @param [in]  rows        Número de filas a añadir.
+     * @param [in]  row_size    Número de valores de cada fila.
+     * @return Puntero al primer valor de las nuevas filas, o nullptr si no se
+     *         pueden añadir.
+     **/
+    void* addEmptyRows (size_t value_size, size_t rows, unsigned int row_size) {
+        if (value_size != sizeof(T) || (N > 0 && row_size != N) ||
+            !is_fixed || (this->rows > 0 && stride != row_size))
+            return nullptr;
+
+        if (this->rows == 0 && reserved_rows > rows)
+            this->data.reserve(reserved_rows * row_size);
+
+        size_t begin = this->data.size();
+        stride = row_size;
+        this->data.resize(begin + rows * row_size);
+        this->rows += rows;
+        return this->data.data() + begin;
+    }
+
     /**
-     * Obtiene el vector que se encuentra en la posición deseada.
-     * 
-     * @param [in]  index   Índice del vector a obtener.
-     * @param [out] data    Vector vacio donde se almacena el resultado.
+     * Reserva memoria para añadir más filas sin que los vectores tengan que
+     * crecer. Si las filas todavía tienen el mismo tamaño también se tienen
+     * en cuenta por si después dejan de tenerlo.
+     *
+     * @param [in]  rows    Número de filas que se van a añadir.
+     * @param [in]  values  Número total de valores de esas filas.
+     **/
+    void reserve (size_t rows, size_t values) {
+        this->data.reserve(this->data.size() + values);
+
+        if (N == 0 && !is_fixed)
+            offsets.reserve(offsets.size() + rows);
+        else
+            reserved_rows = std::max<size_t>(reserved_rows, this->rows + rows);
+    }
+
+    /**
+     * Obtiene la fila que se encuentra en la posición deseada.
+     *
+     * @param [in]  index   Índice de la fila a obtener.
+     * @param [out] data    Vector donde se almacena el resultado.
      **/
     void getData (unsigned int index, std::vector<double>& data) {
-        data = std::vector<double> (this->data[index].begin(), this->data[index].end());
+        data.assign(this->data.begin() + rowBegin(index), this->data.begin() + rowEnd(index));
     }
-    
+
+    /**
+     * Obtiene un único valor convertido a double, sin reservar memoria.
+     *
+     * @param [in]  index   Índice de la fila.
+     * @param [in]  column  Posición del valor dentro de la fila.
+     * @return El valor deseado.
+     **/
+    double getValue (unsigned int index, unsigned int column) {
+        return data[rowBegin(index) + column];
+    }
+
+    /**
+     * Devuelve una vista de la fila deseada en su tipo nativo, sin copiarla.
+     * La vista deja de ser válida si se añaden o modifican filas.
+     *
+     * @param [in]  index   Índice de la fila.
+     * @return Vista de la fila.
+     **/
+    RowView<stored_type, N> getRow (size_t index) const {
+        return RowView<stored_type, N>(data.data() + rowBegin(index), rowEnd(index) - rowBegin(index));
+    }
+
     /**
-     * Modifica los valores del elemento deseado.
-     * @param [in] index    Índice del vector a modificar
-     * @param [in] new_data     Vector que sustituye al vector original
+     * Devuelve todos los valores en su tipo nativo, una fila detrás de otra.
+     * El puntero deja de ser válido si se añaden o modifican filas.
+     *
+     * @param [out] amount  Cantidad de valores.
+     * @return Puntero al primer valor.
+     **/
+    const stored_type* getValues (size_t& amount) const {
+        amount = data.size();
+        return data.data();
+    }
+
+    /**
+     * Devuelve todos los valores en su tipo nativo para modificarlos sin
+     * cambiar el tamaño de las filas.
+     * El puntero deja de ser válido si se añaden o modifican filas.
+     *
+     * @param [out] amount  Cantidad de valores.
+     * @return Puntero al primer valor.
+     **/
+    stored_type* getValues (size_t& amount) {
+        amount = data.size();
+        return data.data();
+    }
+
+    /**
+     * Conserva solo las filas indicadas y las mueve al principio sin cambiar
+     * su orden. El resto de filas se eliminan.
+     *
+     * @param [in]  kept    Índices de las filas a conservar, de menor a mayor.
+     **/
+    void selectRows (const std::vector<unsigned int>& kept) {
+        size_t position = 0;
+
+        for (size_t i = 0; i < kept.size(); ++i) {
+            size_t begin = rowBegin(kept[i]);
+            size_t end = rowEnd(kept[i]);
+
+            if (position < begin)
+                std::copy(data.begin() + begin, data.begin() + end, data.begin() + position);
+            position += end - begin;
+
+            if (N == 0 && !is_fixed)
+                offsets[i + 1] = position;
+        }
+
+        data.resize(position);
+        rows = kept.size();
+        if (N == 0 && !is_fixed)
+            offsets.resize(rows + 1);
+    }
+
+    /**
+     * Modifica los valores de la fila deseada. Si cambia de tamaño el resto de
+     * valores se desplazan para mantener las filas contiguas.
+     * @param [in] index    Índice de la fila a modificar
+     * @param [in] new_data     Vector que sustituye a la fila original
      **/
     void modifyData (unsigned int index, std::vector<double>& new_data) {
-        data[index].clear();
-        
-        std::vector<T> aux (new_data.begin(), new_data.end());
-        this->data[index] = aux;
+        size_t begin = rowBegin(index);
+        size_t old_size = rowEnd(index) - begin;
+        size_t new_size = new_data.size();
+
+        if (new_size != old_size) {
+            if (N > 0) {
+                std::cout << "El conjunto de datos " << getName() << " solo admite filas de " << N << " valores." << std::endl;
+                return;
+            }
+
+            makeVariable();
+
+            if (new_size > old_size)
+                data.insert(data.begin() + begin + old_size, new_size - old_size, stored_type());
+            else
+                data.erase(data.begin() + begin + new_size, data.begin() + begin + old_size);
+
+            for (size_t i = index + 1; i <= rows; ++i) {
+                offsets[i] = offsets[i] + new_size - old_size;
+            }
+        }
+
+        std::copy(new_data.begin(), new_data.end(), data.begin() + begin);
     }
-    
+
     /**
-     * Devuelve la cantidad de elementos que el vector de vectores tiene.
+     * Devuelve la cantidad de filas almacenadas.
      **/
     size_t size() {
-        return data.size();
+        return rows;
     }
-    
+
     /**
-     * Devuelve la cantidad de elementos que el vector en la posición deseada
+     * Devuelve la cantidad de elementos que la fila en la posición deseada
      * tiene.
-     * Si el índice es mayor al número de elementos se muestra un mensaje de
+     * Si el índice es mayor al número de filas se muestra un mensaje de
      * error y se devuelve 0.
-     * 
-     * @param [in]  element Índice del vector a obtener su tamaño.
-     * @return El numero de elementos que contiene el vector deseado, 0 si no se
+     *
+     * @param [in]  element Índice de la fila a obtener su tamaño.
+     * @return El numero de elementos que contiene la fila deseada, 0 si no se
      *         encuentra.
      **/
     size_t getDataDimension(unsigned int element) {
-        if (element >= data.size()){
+        if (element >= rows){
             std::cout << "No se ha encontrado el elemento numero " << element << "." << std::endl;
             return 0;
         }
         else
-            return data[element].size();
+            return rowEnd(element) - rowBegin(element);
     }
-    
-    
+
+    /**
+     * Si todas las filas tienen el mismo tamaño y existe una especialización
+     * para él (3 para double, 2, 3, 4 u 8 para unsigned int) crea un
+     * conj. de datos de tamaño fijo que adopta los valores de este.
+     *
+     * @return El nuevo conj. de datos o nullptr si no se puede crear.
+     **/
+    DatasetAbstract* createFixedArity() {
+        if (N > 0 || !is_fixed || rows == 0)
+            return nullptr;
+
+        if constexpr (N == 0 && std::is_same<T, double>::value) {
+            if (stride == 3)
+                return new Dataset<T, 3>(getName(), std::move(data));
+        }
+        else if constexpr (N == 0 && std::is_same<T, unsigned int>::value) {
+            switch (stride) {
+                case 2 : return new Dataset<T, 2>(getName(), std::move(data));
+                case 3 : return new Dataset<T, 3>(getName(), std::move(data));
+                case 4 : return new Dataset<T, 4>(getName(), std::move(data));
+                case 8 : return new Dataset<T, 8>(getName(), std::move(data));
+                default: break;
+            }
+        }
+
+        return nullptr;
+    }
+
+
     Dataset(const Dataset& orig) {};
     virtual ~Dataset() {}
 private:
-    std::vector<std::vector<T>> data; ///< Vector de vectores con la información.
+    std::pmr::vector<stored_type> data;  ///< Valores de todas las filas, una detrás de otra.
+    std::pmr::vector<size_t> offsets;    ///< Comienzo de cada fila y final de la última. Vacio mientras todas tienen el mismo tamaño.
+    size_t rows;                    ///< Número de filas.
+    size_t stride;                  ///< Tamaño de las filas mientras todas son iguales.
+    size_t reserved_rows;           ///< Filas a reservar cuando se conozca el tamaño de la primera.
+    bool is_fixed;                  ///< Indica si todas las filas tienen el mismo tamaño.
+
+    /**
+     * Devuelve la posición del primer valor de una fila.
+     **/
+    size_t rowBegin(size_t index) const {
+        if (N > 0)
+            return index * N;
+        return is_fixed ? index * stride : offsets[index];
+    }
+
+    /**
+     * Devuelve la posición siguiente al último valor de una fila.
+     **/
+    size_t rowEnd(size_t index) const {
+        if (N > 0)
+            return (index + 1) * N;
+        return is_fixed ? (index + 1) * stride : offsets[index + 1];
+    }
+
+    /**
+     * Actualiza el índice de filas antes de añadir una nueva fila al final.
+     * Con la primera fila se reserva la memoria indicada en el constructor.
+     *
+     * @param [in]  size    Tamaño de la nueva fila.
+     * @return false si la fila no se puede añadir porque su tamaño no es N.
+     **/
+    bool prepareRow(size_t size) {
+        if (N > 0) {
+            if (size != N) {
+                std::cout << "El conjunto de datos " << getName() << " solo admite filas de " << N << " valores." << std::endl;
+                return false;
+            }
+        }
+        else if (rows == 0 && is_fixed) {
+            stride = size;
+            if (reserved_rows > 0)
+                data.reserve(reserved_rows * size);
+        }
+        else if (is_fixed && size != stride) {
+            makeVariable();
+        }
+
+        ++rows;
+        if (!is_fixed)
+            offsets.push_back(data.size() + size);
+        return true;
+    }
+
+    /**
+     * Pasa a guardar el comienzo de cada fila porque ya no todas tienen el
+     * mismo tamaño.
+     **/
+    void makeVariable() {
+        if (!is_fixed)
+            return;
+
+        //Se reservan también las filas que faltan por añadir
+        offsets.reserve(std::max<size_t>(reserved_rows, rows) + 1);
+        offsets.resize(rows + 1);
+        for (size_t i = 0; i <= rows; ++i) {
+            offsets[i] = i * stride;
+        }
+        is_fixed = false;
+    }
 
     /**
      * Función de ayuda para comprobar los datos almacenados.
      **/
     void printDataset() {
-        for (auto vector : data) {
-            for (auto num : vector) {
-                std::cout << num << ", ";
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = rowBegin(i); j < rowEnd(i); ++j) {
+                std::cout << printable(data[j]) << ", ";
             }
             std::cout << std::endl;
 
@@ -138,5 +450,49 @@ private:
 
 };
 
-#endif /* DATASETDOUBLE_H */
+/**
+ * Final de la recursión: ninguna clase coincide.
+ **/
+template <typename F>
+bool visitDatasetAs(DatasetAbstract*, F&) {
+    return false;
+}
+
+/**
+ * Prueba las clases concretas de Dataset una a una hasta encontrar la del
+ * conj. de datos.
+ *
+ * @tparam D        Clase concreta a probar.
+ * @tparam Rest     Resto de clases concretas.
+ **/
+template <typename F, typename D, typename... Rest>
+bool visitDatasetAs(DatasetAbstract* dataset, F& function) {
+    if (auto typed = dynamic_cast<D*>(dataset)) {
+        function(*typed);
+        return true;
+    }
+    return visitDatasetAs<F, Rest...>(dataset, function);
+}
 
+/**
+ * Llama a una función con el conj. de datos convertido a su clase concreta,
+ * para poder recorrer sus filas en su tipo nativo con Dataset::getRow. La
+ * función debe aceptar cualquier Dataset<T, N>, por ejemplo una lambda con un
+ * parámetro auto&. Primero se prueban las especializaciones de tamaño fijo.
+ *
+ * @param [in]  dataset     Conj. de datos a recorrer.
+ * @param [in]  function    Función que recibe el Dataset<T, N> concreto.
+ * @return false si el tipo de dato del conj. de datos no esta soportado.
+ **/
+template <typename F>
+bool visitDataset(DatasetAbstract* dataset, F function) {
+    return visitDatasetAs<F,
+                          Dataset<double, 3>, Dataset<unsigned int, 2>, Dataset<unsigned int, 3>,
+                          Dataset<unsigned int, 4>, Dataset<unsigned int, 8>,
+                          Dataset<double>, Dataset<float>, Dataset<unsigned int>, Dataset<int>,
+                          Dataset<unsigned short>, Dataset<short>, Dataset<unsigned char>,
+                          Dataset<signed char>, Dataset<char>, Dataset<bool>, Dataset<long long>,
+                          Dataset<unsigned long long>, Dataset<int64_t>, Dataset<uint64_t>>(dataset, function);
+}
+
+#endif /* DATASETDOUBLE_H */
@@ -0,0 +1,159 @@
+/**
+ * @file DatasetContext.cpp
+ * 
+ * Clase que representa una conversión. Es la dueña de todos los conj. de datos
+ * extraidos de un fichero de entrada y proporciona un acceso único a estos por
+ * su nombre. Los valores de los conj. de datos y las estructuras auxiliares de
+ * los ficheros de salida se reservan en una arena propia (monotonic buffer),
+ * que se libera de una sola vez al destruir el contexto. Así varias
+ * conversiones pueden convivir en el mismo proceso sin compartir nada, aunque
+ * un mismo contexto solo debe usarse desde un hilo.
+ * 
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ * 
+ **/
+
+#include "DatasetContext.h"
+#include "DatasetAbstract.h"
+#include <unordered_map>
+#include <string>
+#include <memory>
+#include <memory_resource>
+#include <functional>
+#include <iostream>
+using namespace std;
+
+static const size_t ARENA_FIRST_BLOCK = 1 << 16;   ///< Tamaño en bytes del primer bloque de la arena.
+
+/**
+ * Constructor. Crea un contexto vacio, sin conj. de datos ni función de carga.
+ * La arena pide memoria al sistema en bloques cada vez más grandes según se
+ * necesita.
+ **/
+DatasetContext::DatasetContext() : arena(ARENA_FIRST_BLOCK) {
+}
+
+/**
+ * Crea un conj. de datos con el método factoría y lo registra con su nombre.
+ * El contexto es el dueño del conj. de datos y sus valores se guardan en la
+ * arena. Si ya existe uno con el mismo
+ * nombre se conserva el primero para las búsquedas.
+ * 
+ * @param [in]  type    El tipo de dato en el que almacenara la información
+ *                      internamente (float, unsigned int, etc)
+ * @param [in]  name    Nombre y llave que identifica al conj. de datos.
+ * @param [in]  size    Cantidad de filas a reservar.
+ * @return Puntero al conj. de datos creado, nullptr si el tipo no se soporta.
+ **/
+DatasetAbstract* DatasetContext::createDataset(const string& type, const string& name, unsigned int size = 0) {
+    DatasetAbstract* pointer = DatasetAbstract::FactoryDataset(type, name, size, &arena);
+    
+    if (pointer != nullptr) {
+        datasets.emplace_back(pointer);
+        dataset_names.emplace(name, pointer);
+    }
+    
+    return pointer;
+}
+
+/**
+ * Dado un nombre la función trata de buscar el conjunto de datos con la llave
+ * correspondiende. Si no se encuentra y hay una función de carga se le pide
+ * que lo cree antes de darlo por perdido.
+ * 
+ * @param [in]  name    Nombre y llave del conj. de datos del que queremos acceso.
+ * @return Devuelve un puntero al conj. de datos si lo encuentra, nullptr en
+ *         caso contrario.
+ **/
+DatasetAbstract* DatasetContext::getDataset(const string& name) {
+    DatasetAbstract* result;
+    
+    auto search = dataset_names.find(name);
+    if (search == dataset_names.end() && loader && loader(name))
+        search = dataset_names.find(name);
+    
+    if (search != dataset_names.end())
+        result = search->second;
+    else {
+        cout << "No se ha encontrado el conjunto de datos llamado " << name << endl;
+        result = nullptr;
+    }
+    
+    return result;
+}
+
+/**
+ * Establece la función que se llama cuando se busca un conj. de datos que no
+ * existe. La función recibe el nombre del conj. de datos, lo crea si puede y
+ * devuelve si lo ha creado. Una función vacia deshabilita la carga.
+ * 
+ * @param [in]  new_loader  Función de carga bajo demanda.
+ **/
+void DatasetContext::setLoader(const function<bool(const string&)>& new_loader) {
+    loader = new_loader;
+}
+
+/**
+ * Sustituye un conj. de datos por su especialización de tamaño de fila fijo
+ * si todas sus filas tienen el mismo tamaño y existe una para él. Los valores
+ * no se copian, la nueva instancia los adopta. Solo debe llamarse cuando nadie
+ * guarda ya un puntero al conj. de datos original y no se van a añadir filas
+ * de otro tamaño.
+ * 
+ * @param [in]  name    Nombre del conj. de datos.
+ **/
+void DatasetContext::fixArity(const string& name) {
+    auto search = dataset_names.find(name);
+    if (search == dataset_names.end())
+        return;
+    
+    DatasetAbstract* fixed = search->second->createFixedArity();
+    if (fixed == nullptr)
+        return;
+    
+    for (auto& dataset : datasets) {
+        if (dataset.get() == search->second) {
+            dataset.reset(fixed);
+            break;
+        }
+    }
+    search->second = fixed;
+}
+
+/**
+ * Devuelve la arena del contexto, para que los ficheros de salida reserven en
+ * ella sus estructuras auxiliares. Lo que se reserve en ella no se libera
+ * hasta que se destruye el contexto, aunque se devuelva antes.
+ * 
+ * @return Recurso de memoria de la arena.
+ **/
+pmr::memory_resource* DatasetContext::getResource() {
+    return &arena;
+}
+
+/**
+ * Devuelve los nombres de todos los conj. de datos del contexto, sin pedir a
+ * la función de carga los que todavía no se han creado.
+ * 
+ * @return Vector con los nombres.
+ **/
+vector<string> DatasetContext::getNames() {
+    vector<string> names;
+    names.reserve(dataset_names.size());
+    
+    for (const auto& dataset : dataset_names) {
+        names.push_back(dataset.first);
+    }
+    
+    return names;
+}
+
+/**
+ * Destructor. Libera todos los conj. de datos del contexto y después toda la
+ * memoria de la arena de una vez. Los punteros que se hayan obtenido de él
+ * dejan de ser válidos.
+ **/
+DatasetContext::~DatasetContext() {
+}
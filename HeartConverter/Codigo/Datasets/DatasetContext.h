@@ -0,0 +1,53 @@
+/**
+ * @file DatasetContext.h
+ * 
+ * Clase que representa una conversión. Es la dueña de todos los conj. de datos
+ * extraidos de un fichero de entrada y proporciona un acceso único a estos por
+ * su nombre. Los valores de los conj. de datos y las estructuras auxiliares de
+ * los ficheros de salida se reservan en una arena propia (monotonic buffer),
+ * que se libera de una sola vez al destruir el contexto. Así varias
+ * conversiones pueden convivir en el mismo proceso sin compartir nada, aunque
+ * un mismo contexto solo debe usarse desde un hilo.
+ * 
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ * 
+ **/
+
+#ifndef DATASETCONTEXT_H
+#define DATASETCONTEXT_H
+
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <memory>
+#include <memory_resource>
+#include <functional>
+
+class DatasetAbstract;
+
+class DatasetContext {
+public:
+    DatasetContext();
+    
+    DatasetAbstract* createDataset (const std::string&, const std::string&, unsigned int);
+    DatasetAbstract* getDataset (const std::string&);
+    void setLoader (const std::function<bool(const std::string&)>&);
+    void fixArity (const std::string&);
+    std::pmr::memory_resource* getResource ();
+    std::vector<std::string> getNames ();
+    
+    DatasetContext(const DatasetContext&) = delete;
+    DatasetContext& operator=(const DatasetContext&) = delete;
+    
+    ~DatasetContext();
+    
+private:
+    std::pmr::monotonic_buffer_resource arena; ///< Arena de la que se reserva toda la memoria. Se declara primero para destruirse la última.
+    std::vector<std::unique_ptr<DatasetAbstract>> datasets; ///< Conj. de datos de los que es dueño el contexto.
+    std::unordered_map<std::string, DatasetAbstract*> dataset_names; ///< Tabla hash donde se buscan los conj. de datos por nombre.
+    std::function<bool(const std::string&)> loader; ///< Función que crea bajo demanda los conj. de datos que no se han cargado.
+};
+
+#endif /* DATASETCONTEXT_H */
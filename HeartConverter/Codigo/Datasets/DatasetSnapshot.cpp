@@ -0,0 +1,372 @@
+/**
+ * @file DatasetSnapshot.cpp
+ *
+ * Clase que guarda en disco los conj. de datos de una conversión tras leer el
+ * fichero de entrada, para que las siguientes conversiones del mismo fichero
+ * no tengan que volver a leerlo. El fichero de la caché se identifica por un
+ * hash del contenido del fichero de entrada, tiene una versión y sus valores
+ * estan alineados para poder leerse directamente de su proyección en memoria.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#include "DatasetSnapshot.h"
+#include "DatasetContext.h"
+#include "DatasetAbstract.h"
+#include "Dataset.h"
+#include "../Inputs/MappedFile.h"
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <sys/stat.h>
+using namespace std;
+
+static const char SNAPSHOT_MAGIC[8] = {'H', 'C', 'S', 'N', 'A', 'P', '\0', '\0'};  ///< Identificador del formato.
+static const uint32_t SNAPSHOT_VERSION = 1;         ///< Cambiar al modificar el formato o cómo se leen las entradas.
+static const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+static const size_t SNAPSHOT_ALIGNMENT = 8;        ///< Alineamiento de cada bloque del fichero.
+
+/**
+ * Redondea una posición al siguiente múltiplo del alineamiento.
+ **/
+static size_t align(size_t position) {
+    return (position + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+}
+
+/**
+ * Escribe un bloque de bytes y los ceros necesarios para que el siguiente
+ * bloque quede alineado.
+ *
+ * @param [in,out]  file        Fichero de salida.
+ * @param [in]      data        Bytes a escribir.
+ * @param [in]      size        Número de bytes.
+ **/
+static void writeAligned(ofstream& file, const void* data, size_t size) {
+    static const char zeros[SNAPSHOT_ALIGNMENT] = {};
+
+    file.write(static_cast<const char*>(data), size);
+    file.write(zeros, align(size) - size);
+}
+
+/**
+ * Devuelve el nombre del tipo de dato que entiende DatasetAbstract::FactoryDataset.
+ *
+ * @tparam T    Tipo de dato del conj. de datos.
+ **/
+template <typename T>
+static string nativeTypeName() {
+    if constexpr (is_same<T, bool>::value)                   return "bool";
+    else if constexpr (is_same<T, char>::value)              return "char";
+    else if constexpr (is_same<T, unsigned char>::value)     return "unsigned char";
+    else if constexpr (is_same<T, signed char>::value)       return "signed char";
+    else if constexpr (is_same<T, short>::value)             return "short";
+    else if constexpr (is_same<T, unsigned short>::value)    return "unsigned short";
+    else if constexpr (is_same<T, int>::value)               return "int";
+    else if constexpr (is_same<T, unsigned int>::value)      return "unsigned int";
+    else if constexpr (is_same<T, float>::value)             return "float";
+    else if constexpr (is_same<T, double>::value)            return "double";
+    else if constexpr (is_same<T, long long>::value)         return "long long";
+    else if constexpr (is_same<T, unsigned long long>::value) return "unsigned long long";
+    else if constexpr (is_same<T, int64_t>::value)           return "int64_t";
+    else if constexpr (is_same<T, uint64_t>::value)          return "uint64_t";
+    else                                                      return "";
+}
+
+/**
+ * Constructor. Calcula el hash del fichero de entrada y a partir de él el
+ * nombre del fichero de la caché dentro del directorio indicado.
+ *
+ * @param [in]  cache_dir   Directorio donde se guardan los ficheros de la caché.
+ * @param [in]  input_file  Fichero de entrada de la conversión.
+ **/
+DatasetSnapshot::DatasetSnapshot(const string& cache_dir, const string& input_file) {
+    input_hash = 0;
+    input_size = 0;
+    is_valid = false;
+
+    MappedFile input(input_file);
+    if (!input.isOpen())
+        return;
+
+    input_size = input.size();
+    input_hash = hashContent(input.data(), input.size());
+    is_valid = true;
+
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(input_hash));
+    file_name = cache_dir + "/" + hex + ".hcsnap";
+}
+
+/**
+ * Crea los conj. de datos guardados en la caché si esta existe, corresponde
+ * al fichero de entrada y contiene los arrays indicados. Los valores se copian
+ * desde la proyección en memoria de la caché sin convertirlos. Todo el
+ * fichero se comprueba antes de crear ningún conj. de datos.
+ *
+ * @param [in]  arrays      Nombres de los arrays de atributos que se necesitan.
+ * @param [in]  fixed_arity Indica si los puntos y elementos pueden pasar a
+ *                          conj. de datos de tamaño de fila fijo.
+ * @param [in]  context     Contexto en el que se crean los conj. de datos.
+ * @return true si se han creado los conj. de datos desde la caché.
+ **/
+bool DatasetSnapshot::load(const vector<string>& arrays, bool fixed_arity, DatasetContext& context) {
+    if (!is_valid)
+        return false;
+
+    MappedFile snapshot(file_name);
+    if (!snapshot.isOpen() || snapshot.size() < sizeof(Header))
+        return false;
+
+    const char* begin = snapshot.data();
+    const char* end = begin + snapshot.size();
+
+    Header header;
+    memcpy(&header, begin, sizeof(Header));
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 ||
+        header.version != SNAPSHOT_VERSION || header.byte_order != SNAPSHOT_BYTE_ORDER ||
+        header.input_hash != input_hash || header.input_size != input_size)
+        return false;
+
+    const char* cursor = begin + align(sizeof(Header));
+    bool is_damaged = false;
+
+    //Devuelve el siguiente bloque alineado o nullptr si el fichero no es tan largo
+    auto take = [&](size_t size) -> const char* {
+        if (is_damaged || size > static_cast<size_t>(end - cursor)) {
+            is_damaged = true;
+            return nullptr;
+        }
+        const char* block = cursor;
+        cursor += min(align(size), static_cast<size_t>(end - cursor));
+        return block;
+    };
+
+    vector<string> known;
+    for (uint32_t i = 0; i < header.requested && !is_damaged; ++i) {
+        uint32_t size;
+        const char* block = take(sizeof(size));
+        if (block == nullptr)
+            break;
+        memcpy(&size, block, sizeof(size));
+
+        block = take(size);
+        if (block != nullptr)
+            known.push_back(string(block, size));
+    }
+
+    //Conj. de datos guardado en la caché
+    typedef struct Stored {
+        Entry entry;                ///< Descripción del conj. de datos.
+        string name;                ///< Nombre.
+        string type;                ///< Tipo de dato.
+        const uint32_t* row_sizes;  ///< Tamaño de cada fila si no son todas iguales.
+        const char* values;         ///< Valores de todas las filas.
+    } Stored;
+
+    vector<Stored> stored;
+    for (uint32_t i = 0; i < header.datasets && !is_damaged; ++i) {
+        Stored dataset;
+        const char* block = take(sizeof(Entry));
+        if (block == nullptr)
+            break;
+        memcpy(&dataset.entry, block, sizeof(Entry));
+        const Entry& entry = dataset.entry;
+
+        block = take(entry.name_size);
+        if (block != nullptr)
+            dataset.name.assign(block, entry.name_size);
+        block = take(entry.type_size);
+        if (block != nullptr)
+            dataset.type.assign(block, entry.type_size);
+
+        uint64_t values = 0;
+        dataset.row_sizes = nullptr;
+        if (entry.stride > 0) {
+            values = entry.rows * entry.stride;
+        }
+        else if (entry.rows > 0 && entry.rows <= snapshot.size() / sizeof(uint32_t)) {
+            dataset.row_sizes = reinterpret_cast<const uint32_t*>(take(entry.rows * sizeof(uint32_t)));
+            for (uint64_t row = 0; dataset.row_sizes != nullptr && row < entry.rows; ++row) {
+                values += dataset.row_sizes[row];
+            }
+        }
+        else if (entry.rows > 0) {
+            is_damaged = true;
+        }
+
+        if (values != entry.values || entry.value_size == 0 ||
+            entry.values > snapshot.size() / entry.value_size)
+            is_damaged = true;
+
+        dataset.values = take(entry.values * entry.value_size);
+        stored.push_back(dataset);
+    }
+
+    if (is_damaged) {
+        cout << "El fichero de caché " << file_name << " esta dañado, se ignora." << endl;
+        return false;
+    }
+
+    //Los arrays que se pidieron al crear la caché pero no existen tampoco se
+    //tienen que buscar otra vez en el fichero de entrada.
+    for (const auto& name : stored) {
+        known.push_back(name.name);
+    }
+    for (const auto& name : arrays) {
+        if (find(known.begin(), known.end(), name) == known.end())
+            return false;
+    }
+
+    for (const auto& dataset : stored) {
+        const Entry& entry = dataset.entry;
+        DatasetAbstract* created = context.createDataset(dataset.type, dataset.name, entry.rows);
+        if (created == nullptr)
+            continue;
+
+        if (entry.stride > 0) {
+            created->addRawData(dataset.values, entry.value_size, entry.rows, entry.stride);
+        }
+        else {
+            const char* values = dataset.values;
+            for (uint64_t row = 0; row < entry.rows; ++row) {
+                created->addRawData(values, entry.value_size, 1, dataset.row_sizes[row]);
+                values += static_cast<size_t>(dataset.row_sizes[row]) * entry.value_size;
+            }
+        }
+    }
+
+    if (fixed_arity) {
+        context.fixArity("points");
+        context.fixArity("elements");
+    }
+
+    return true;
+}
+
+/**
+ * Guarda en la caché todos los conj. de datos que hay en el contexto. Debe
+ * llamarse justo después de leer el fichero de entrada, antes de que ningún
+ * fichero de salida los modifique. El fichero se escribe primero con otro
+ * nombre y después se renombra, para que otra conversión nunca lea un fichero
+ * a medio escribir.
+ *
+ * @param [in]  arrays  Nombres de los arrays de atributos que se pidieron.
+ * @param [in]  context Contexto del que se obtienen los conj. de datos.
+ **/
+void DatasetSnapshot::save(const vector<string>& arrays, DatasetContext& context) {
+    if (!is_valid)
+        return;
+
+    mkdir(file_name.substr(0, file_name.rfind('/')).c_str(), 0755);
+
+    string temporal_name = file_name + ".tmp";
+    ofstream file(temporal_name, ios::binary | ios::trunc);
+    if (!file.good()) {
+        cout << "No se ha podido crear el fichero de caché " << file_name << endl;
+        return;
+    }
+
+    Header header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.byte_order = SNAPSHOT_BYTE_ORDER;
+    header.input_hash = input_hash;
+    header.input_size = input_size;
+    header.datasets = 0;
+    header.requested = arrays.size();
+    writeAligned(file, &header, sizeof(Header));
+
+    for (const auto& name : arrays) {
+        uint32_t size = name.size();
+        writeAligned(file, &size, sizeof(size));
+        writeAligned(file, name.data(), name.size());
+    }
+
+    vector<uint32_t> row_sizes;
+    for (const auto& name : context.getNames()) {
+        DatasetAbstract* dataset = context.getDataset(name);
+
+        visitDataset(dataset, [&](auto& typed) {
+            typedef typename std::decay<decltype(typed)>::type::value_type value_type;
+            string type = nativeTypeName<value_type>();
+            if (type.empty())
+                return;
+
+            Entry entry;
+            size_t values_amount;
+            const auto* values = typed.getValues(values_amount);
+            entry.values = values_amount;
+            entry.rows = typed.size();
+            entry.value_size = sizeof(*values);
+            entry.stride = (entry.rows > 0) ? typed.getDataDimension(0) : 0;
+            entry.name_size = name.size();
+            entry.type_size = type.size();
+
+            row_sizes.resize(entry.rows);
+            for (size_t row = 0; row < entry.rows; ++row) {
+                row_sizes[row] = typed.getDataDimension(row);
+                if (row_sizes[row] != entry.stride)
+                    entry.stride = 0;
+            }
+
+            writeAligned(file, &entry, sizeof(Entry));
+            writeAligned(file, name.data(), name.size());
+            writeAligned(file, type.data(), type.size());
+            if (entry.stride == 0 && entry.rows > 0)
+                writeAligned(file, row_sizes.data(), row_sizes.size() * sizeof(uint32_t));
+            writeAligned(file, values, entry.values * entry.value_size);
+
+            ++header.datasets;
+        });
+    }
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    file.close();
+
+    if (!file.good() || rename(temporal_name.c_str(), file_name.c_str()) != 0) {
+        cout << "No se ha podido crear el fichero de caché " << file_name << endl;
+        remove(temporal_name.c_str());
+    }
+}
+
+/**
+ * Calcula un hash de 64 bits del contenido de un fichero. Se recorre de 8 en
+ * 8 bytes para que calcularlo sea mucho más rápido que leer el fichero.
+ *
+ * @param [in]  data    Contenido del fichero.
+ * @param [in]  size    Tamaño del fichero.
+ * @return El hash del contenido.
+ **/
+uint64_t DatasetSnapshot::hashContent(const char* data, size_t size) {
+    uint64_t hash = 0x9E3779B97F4A7C15ULL ^ size;
+    size_t words = size / sizeof(uint64_t);
+
+    for (size_t i = 0; i < words; ++i) {
+        uint64_t word;
+        memcpy(&word, data + i * sizeof(uint64_t), sizeof(word));
+        hash ^= word * 0x87C37B91114253D5ULL;
+        hash = ((hash << 31) | (hash >> 33)) * 0x9E3779B97F4A7C15ULL;
+    }
+
+    uint64_t tail = 0;
+    memcpy(&tail, data + words * sizeof(uint64_t), size - words * sizeof(uint64_t));
+    hash ^= tail * 0x87C37B91114253D5ULL;
+
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+
+    return hash;
+}
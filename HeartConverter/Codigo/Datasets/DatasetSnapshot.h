@@ -0,0 +1,69 @@
+/**
+ * @file DatasetSnapshot.h
+ *
+ * Clase que guarda en disco los conj. de datos de una conversión tras leer el
+ * fichero de entrada, para que las siguientes conversiones del mismo fichero
+ * no tengan que volver a leerlo. El fichero de la caché se identifica por un
+ * hash del contenido del fichero de entrada, tiene una versión y sus valores
+ * estan alineados para poder leerse directamente de su proyección en memoria.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#ifndef DATASETSNAPSHOT_H
+#define DATASETSNAPSHOT_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class DatasetContext;
+
+class DatasetSnapshot {
+public:
+    DatasetSnapshot(const std::string&, const std::string&);
+
+    bool load(const std::vector<std::string>&, bool, DatasetContext&);
+    void save(const std::vector<std::string>&, DatasetContext&);
+
+private:
+
+    /**
+     * Cabecera del fichero de la caché.
+     **/
+    typedef struct Header {
+        char magic[8];          ///< Identificador del formato.
+        uint32_t version;       ///< Versión del formato.
+        uint32_t byte_order;    ///< Marca para detectar un orden de bytes distinto.
+        uint64_t input_hash;    ///< Hash del contenido del fichero de entrada.
+        uint64_t input_size;    ///< Tamaño del fichero de entrada.
+        uint32_t datasets;      ///< Número de conj. de datos guardados.
+        uint32_t requested;     ///< Número de arrays que se pidieron al leer la entrada.
+    } Header;
+
+    /**
+     * Descripción de un conj. de datos guardado. Le siguen su nombre, su tipo,
+     * el tamaño de cada fila si no son todas iguales y sus valores.
+     **/
+    typedef struct Entry {
+        uint64_t rows;          ///< Número de filas.
+        uint64_t values;        ///< Número de valores de todas las filas.
+        uint32_t value_size;    ///< Tamaño en bytes de cada valor.
+        uint32_t stride;        ///< Tamaño de todas las filas, 0 si no son iguales.
+        uint32_t name_size;     ///< Longitud del nombre.
+        uint32_t type_size;     ///< Longitud del tipo de dato.
+    } Entry;
+
+    std::string file_name;      ///< Ruta del fichero de la caché.
+    uint64_t input_hash;        ///< Hash del contenido del fichero de entrada.
+    uint64_t input_size;        ///< Tamaño del fichero de entrada.
+    bool is_valid;              ///< Indica si se ha podido leer el fichero de entrada.
+
+    static uint64_t hashContent(const char*, size_t);
+};
+
+#endif /* DATASETSNAPSHOT_H */
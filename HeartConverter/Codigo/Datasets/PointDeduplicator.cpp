@@ -0,0 +1,188 @@
+/**
+ * @file PointDeduplicator.cpp
+ *
+ * Clase que elimina los puntos repetidos de una malla, es decir, los que
+ * tienen exactamente las mismas coordenadas que otro anterior, y actualiza
+ * los índices de los elementos para que usen el primero de ellos. Los puntos
+ * se agrupan ordenando en paralelo un hash de sus coordenadas. Las
+ * estructuras auxiliares son temporales, así que no se reservan en la arena
+ * del contexto sino en vectores normales que se liberan al terminar.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#include "PointDeduplicator.h"
+#include "DatasetContext.h"
+#include "DatasetAbstract.h"
+#include "Dataset.h"
+#include "../Parallel.h"
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <iostream>
+#include <cstring>
+#include <cstdint>
+using namespace std;
+
+static const size_t DEDUP_CHUNK = 1 << 14;  ///< Puntos o valores que procesa cada tarea.
+
+/**
+ * Constructor.
+ *
+ * @param [in]  context Contexto con los conj. de datos "points" y "elements".
+ **/
+PointDeduplicator::PointDeduplicator(DatasetContext& context) {
+    points = context.getDataset("points");
+    elements = context.getDataset("elements");
+}
+
+/**
+ * Elimina los puntos repetidos. Se calcula en paralelo un hash de las
+ * coordenadas de cada punto y se ordena, de forma que los puntos iguales
+ * quedan seguidos. Cada grupo con el mismo hash se compara en paralelo con
+ * el resto y cada punto se sustituye por el primero con sus mismas
+ * coordenadas. Los puntos que se conservan no cambian de orden, así que si
+ * no hay puntos repetidos la malla no cambia.
+ *
+ * @return Número de puntos eliminados.
+ **/
+size_t PointDeduplicator::removeDuplicates() {
+    if (points == nullptr || elements == nullptr)
+        return 0;
+
+    size_t points_amount = points->size();
+    size_t tasks = (points_amount + DEDUP_CHUNK - 1) / DEDUP_CHUNK;
+
+    vector<PointKey> keys(points_amount);
+    vector<unsigned int> first(points_amount);
+    size_t removed = 0;
+
+    visitDataset(points, [&](auto& typed_points) {
+
+        auto samePoint = [&](unsigned int a, unsigned int b) {
+            auto row_a = typed_points.getRow(a);
+            auto row_b = typed_points.getRow(b);
+            return row_a.size() == row_b.size() && equal(row_a.begin(), row_a.end(), row_b.begin());
+        };
+
+        parallelFor(tasks, [&](size_t task) {
+            size_t end = min(points_amount, (task + 1) * DEDUP_CHUNK);
+            for (size_t i = task * DEDUP_CHUNK; i < end; ++i) {
+                uint64_t hash = 0;
+                for (auto a : typed_points.getRow(i)) {
+                    //Sumar 0.0 convierte -0.0 en 0.0, que son iguales al compararlos
+                    double value = (double) a + 0.0;
+                    uint64_t bits;
+                    memcpy(&bits, &value, sizeof(bits));
+                    hash = (hash ^ bits) * 0x9E3779B97F4A7C15ULL;
+                    hash ^= hash >> 29;
+                }
+                keys[i] = {hash, (unsigned int) i};
+                first[i] = i;
+            }
+        });
+
+        sortKeys(keys);
+
+        //Cada tarea empieza en el primer grupo que comienza dentro de su parte
+        auto groupBegin = [&](size_t position) {
+            while (position > 0 && position < points_amount && keys[position].hash == keys[position - 1].hash)
+                ++position;
+            return min(position, points_amount);
+        };
+
+        parallelFor(tasks, [&](size_t task) {
+            size_t end = groupBegin((task + 1) * DEDUP_CHUNK);
+            for (size_t i = groupBegin(task * DEDUP_CHUNK); i < end; ) {
+                size_t group_end = i + 1;
+                while (group_end < points_amount && keys[group_end].hash == keys[i].hash)
+                    ++group_end;
+
+                //Dentro de un grupo los puntos estan ordenados por su índice
+                for (size_t j = i + 1; j < group_end; ++j) {
+                    for (size_t k = i; k < j; ++k) {
+                        unsigned int other = keys[k].point;
+                        if (first[other] == other && samePoint(keys[j].point, other)) {
+                            first[keys[j].point] = other;
+                            break;
+                        }
+                    }
+                }
+                i = group_end;
+            }
+        });
+
+        //Nuevo índice de cada punto y puntos que se conservan
+        vector<unsigned int> kept;
+        kept.reserve(points_amount);
+        for (size_t i = 0; i < points_amount; ++i) {
+            if (first[i] == i) {
+                first[i] = kept.size();
+                kept.push_back(i);
+            }
+            else {
+                first[i] = first[first[i]];
+            }
+        }
+
+        removed = points_amount - kept.size();
+        if (removed > 0) {
+            typed_points.selectRows(kept);
+            remapElements(first);
+        }
+    });
+
+    cout << "Puntos repetidos eliminados: " << removed << " de " << points_amount << endl;
+
+    return removed;
+}
+
+/**
+ * Ordena los hash de los puntos. Cada hilo ordena una parte y después las
+ * partes se mezclan de dos en dos, también en paralelo.
+ *
+ * @param [in,out]  keys    Hash e índice de cada punto.
+ **/
+void PointDeduplicator::sortKeys(vector<PointKey>& keys) {
+    size_t parts = max<size_t>(1, min<size_t>(getThreadsAmount(), keys.size() / DEDUP_CHUNK));
+    size_t part_size = (keys.size() + parts - 1) / parts;
+
+    auto partBegin = [&](size_t part) {
+        return keys.begin() + min(keys.size(), part * part_size);
+    };
+
+    parallelFor(parts, [&](size_t part) {
+        sort(partBegin(part), partBegin(part + 1));
+    });
+
+    for (size_t width = 1; width < parts; width *= 2) {
+        parallelFor((parts + 2 * width - 1) / (2 * width), [&](size_t merge) {
+            size_t begin = merge * 2 * width;
+            inplace_merge(partBegin(begin), partBegin(begin + width), partBegin(begin + 2 * width));
+        });
+    }
+}
+
+/**
+ * Sustituye los índices de los puntos de todos los elementos por sus nuevos
+ * índices, en paralelo.
+ *
+ * @param [in]  new_index   Nuevo índice de cada punto.
+ **/
+void PointDeduplicator::remapElements(const vector<unsigned int>& new_index) {
+    visitDataset(elements, [&](auto& typed_elements) {
+        size_t amount;
+        auto values = typed_elements.getValues(amount);
+        typedef typename std::remove_pointer<decltype(values)>::type value_type;
+
+        parallelFor((amount + DEDUP_CHUNK - 1) / DEDUP_CHUNK, [&](size_t task) {
+            size_t end = min(amount, (task + 1) * DEDUP_CHUNK);
+            for (size_t i = task * DEDUP_CHUNK; i < end; ++i) {
+                values[i] = (value_type) new_index[(size_t) values[i]];
+            }
+        });
+    });
+}
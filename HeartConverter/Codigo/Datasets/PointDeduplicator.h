@@ -0,0 +1,54 @@
+/**
+ * @file PointDeduplicator.h
+ *
+ * Clase que elimina los puntos repetidos de una malla, es decir, los que
+ * tienen exactamente las mismas coordenadas que otro anterior, y actualiza
+ * los índices de los elementos para que usen el primero de ellos. Los puntos
+ * se agrupan ordenando en paralelo un hash de sus coordenadas. Las
+ * estructuras auxiliares son temporales, así que no se reservan en la arena
+ * del contexto sino en vectores normales que se liberan al terminar.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#ifndef POINTDEDUPLICATOR_H
+#define POINTDEDUPLICATOR_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class DatasetContext;
+class DatasetAbstract;
+
+class PointDeduplicator {
+public:
+    PointDeduplicator(DatasetContext&);
+
+    size_t removeDuplicates();
+
+private:
+
+    /**
+     * Hash de las coordenadas de un punto junto con su índice.
+     **/
+    typedef struct PointKey {
+        uint64_t hash;          ///< Hash de las coordenadas.
+        unsigned int point;     ///< Índice del punto.
+
+        bool operator< (const PointKey& other) const {
+            return hash < other.hash || (hash == other.hash && point < other.point);
+        }
+    } PointKey;
+
+    void sortKeys(std::vector<PointKey>&);
+    void remapElements(const std::vector<unsigned int>&);
+
+    DatasetAbstract* points;    ///< Coordenadas de los puntos.
+    DatasetAbstract* elements;  ///< Índices de los puntos de cada elemento.
+};
+
+#endif /* POINTDEDUPLICATOR_H */
@@ -0,0 +1,57 @@
+/**
+ * @file RowView.h
+ * 
+ * Vista de solo lectura de una fila de un conj. de datos. No copia ni
+ * convierte los valores, apunta directamente a los que guarda el conj. de
+ * datos en su tipo nativo, por lo que deja de ser válida si se añaden o
+ * modifican filas.
+ * 
+ * @tparam T    El tipo de datos de la fila.
+ * @tparam N    Número de valores de la fila si se conoce al compilar, 0 si no.
+ * 
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ * 
+ **/
+
+#ifndef ROWVIEW_H
+#define ROWVIEW_H
+
+#include <cstddef>
+
+template <typename T, unsigned int N = 0>
+class RowView {
+public:
+    
+    /**
+     * Constructor.
+     * 
+     * @param [in]  first   Puntero al primer valor de la fila.
+     * @param [in]  length  Número de valores de la fila.
+     **/
+    RowView(const T* first, size_t length) : first(first), length(length) {}
+    
+    const T* begin() const { return first; }
+    const T* end() const { return first + size(); }
+    size_t size() const { return (N > 0) ? N : length; }
+    const T& operator[](size_t index) const { return first[index]; }
+    
+private:
+    const T* first;     ///< Puntero al primer valor de la fila.
+    size_t length;      ///< Número de valores de la fila.
+};
+
+/**
+ * Promociona un valor a un tipo que se escribe como número en un "output
+ * stream". Los char se escribirían como carácteres y no como enteros.
+ * 
+ * @param [in]  value   Valor a escribir.
+ * @return El mismo valor como int si es un char, short o bool.
+ **/
+template <typename T>
+inline auto printable(T value) -> decltype(+value) {
+    return +value;
+}
+
+#endif /* ROWVIEW_H */
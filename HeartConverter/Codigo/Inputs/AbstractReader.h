@@ -0,0 +1,92 @@
+/**
+ * @file AbstractReader.h
+ *
+ * Clase abstracta que representa a un lector propio de ficheros de entrada.
+ * Cada lector vuelca la información del fichero directamente en los conjuntos
+ * de datos del contexto de la conversión.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#ifndef ABSTRACTREADER_H
+#define ABSTRACTREADER_H
+
+#include <vtkCellType.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class DatasetContext;
+
+class AbstractReader {
+public:
+
+    /**
+     * Constructor. Guarda el contexto en el que se crean los conj. de datos.
+     *
+     * @param [in]  context Contexto de la conversión, debe de vivir más que
+     *                      el lector.
+     **/
+    AbstractReader(DatasetContext& context) : context(context) {};
+
+    /**
+     * Indica si el lector es capaz de interpretar el fichero que se le ha
+     * suministrado.
+     *
+     * @return true si el fichero puede ser leido, false en caso contrario.
+     **/
+    virtual bool isSupported() = 0;
+
+    /**
+     * Lee el fichero y crea los conj. de datos "points", "elements",
+     * "primitives" y los de los arrays de atributos indicados. Del resto de
+     * arrays solo se recuerda su posición para poder leerlos más tarde.
+     *
+     * @param [in]  arrays  Nombres de los arrays que se leen inmediatamente.
+     **/
+    virtual void read(const std::vector<std::string>& arrays) = 0;
+
+    /**
+     * Crea bajo demanda el conj. de datos de un array que no se leyó con
+     * read().
+     *
+     * @param [in]  name    Nombre del array.
+     * @return true si el array existe en el fichero y se ha creado.
+     **/
+    virtual bool loadArray(const std::string& name) = 0;
+
+    virtual ~AbstractReader() {};
+
+protected:
+
+    DatasetContext& context;    ///< Contexto en el que se crean los conj. de datos.
+
+    /**
+     * Devuelve el tipo de primitiva de un elemento de POLYDATA, que depende de
+     * la sección en la que se encuentra y de su número de puntos.
+     *
+     * @param [in]  kind            Sección (VTK_VERTEX, VTK_LINE, VTK_POLYGON o
+     *                              VTK_TRIANGLE_STRIP).
+     * @param [in]  points_amount   Número de puntos del elemento.
+     * @return El tipo de primitiva de acuerdo a vtkCellType.h.
+     **/
+    static int getPolyCellType(int kind, size_t points_amount) {
+        switch (kind) {
+            case VTK_VERTEX : return (points_amount == 1) ? VTK_VERTEX : VTK_POLY_VERTEX;
+            case VTK_LINE   : return (points_amount == 2) ? VTK_LINE : VTK_POLY_LINE;
+            case VTK_POLYGON:
+                if (points_amount == 3)
+                    return VTK_TRIANGLE;
+                else if (points_amount == 4)
+                    return VTK_QUAD;
+                return VTK_POLYGON;
+            default         : return VTK_TRIANGLE_STRIP;
+        }
+    }
+};
+
+#endif /* ABSTRACTREADER_H */
+
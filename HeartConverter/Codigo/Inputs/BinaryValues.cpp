@@ -0,0 +1,38 @@
+/**
+ * @file BinaryValues.cpp
+ *
+ * Tipos de dato que pueden aparecer en las secciones binarias de los ficheros
+ * de entrada y funciones para convertirlos por bloques al tipo en el que se
+ * almacenan, cambiando el orden de los bytes si es necesario.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#include "BinaryValues.h"
+using namespace std;
+
+/**
+ * Devuelve el tamaño en bytes de cada valor. Los bits se empaquetan de 8 en 8
+ * y se tratan aparte.
+ *
+ * @param [in]  kind    Tipo de dato.
+ * @return El tamaño en bytes o 0 si el tipo no tiene un tamaño fijo.
+ **/
+size_t getValueSize(ValueKind kind) {
+    switch (kind) {
+        case KIND_INT8   :
+        case KIND_UINT8  : return 1;
+        case KIND_INT16  :
+        case KIND_UINT16 : return 2;
+        case KIND_INT32  :
+        case KIND_UINT32 :
+        case KIND_FLOAT32: return 4;
+        case KIND_INT64  :
+        case KIND_UINT64 :
+        case KIND_FLOAT64: return 8;
+        default          : return 0;
+    }
+}
@@ -0,0 +1,107 @@
+/**
+ * @file BinaryValues.h
+ *
+ * Tipos de dato que pueden aparecer en las secciones binarias de los ficheros
+ * de entrada y funciones para convertirlos por bloques al tipo en el que se
+ * almacenan, cambiando el orden de los bytes si es necesario.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#ifndef BINARYVALUES_H
+#define BINARYVALUES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+/**
+ * Tipos de dato de las secciones de datos de un fichero.
+ **/
+enum ValueKind {
+    KIND_BIT, KIND_INT8, KIND_UINT8, KIND_INT16, KIND_UINT16, KIND_INT32,
+    KIND_UINT32, KIND_INT64, KIND_UINT64, KIND_FLOAT32, KIND_FLOAT64, KIND_UNKNOWN
+};
+
+size_t getValueSize(ValueKind);
+
+/**
+ * Indica si la máquina en la que se ejecuta el programa es "big endian".
+ **/
+inline bool isBigEndianHost() {
+    return __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+}
+
+inline uint8_t  byteSwap(uint8_t value)  { return value; }
+inline uint16_t byteSwap(uint16_t value) { return __builtin_bswap16(value); }
+inline uint32_t byteSwap(uint32_t value) { return __builtin_bswap32(value); }
+inline uint64_t byteSwap(uint64_t value) { return __builtin_bswap64(value); }
+
+/**
+ * Convierte un bloque de valores del tipo S al tipo D. Los bytes se invierten
+ * en el tipo del fichero y después se convierte cada valor. El bucle no tiene
+ * dependencias entre iteraciones para que el compilador lo vectorice.
+ *
+ * @tparam S    Tipo de dato en el fichero.
+ * @tparam U    Entero sin signo del mismo tamaño que S.
+ * @tparam D    Tipo de dato del destino.
+ * @param [in]  source      Puntero a los datos del fichero.
+ * @param [in]  count       Número de valores a convertir.
+ * @param [out] destination Array donde se almacenan los valores.
+ * @param [in]  swap_bytes  Indica si hay que invertir el orden de los bytes.
+ **/
+template <typename S, typename U, typename D>
+void convertBlock(const char* source, size_t count, D* destination, bool swap_bytes) {
+    static_assert(sizeof(S) == sizeof(U), "S y U deben tener el mismo tamaño");
+
+    if (swap_bytes) {
+        for (size_t i = 0; i < count; ++i) {
+            U raw;
+            memcpy(&raw, source + i * sizeof(U), sizeof(U));
+            raw = byteSwap(raw);
+            S value;
+            memcpy(&value, &raw, sizeof(S));
+            destination[i] = static_cast<D>(value);
+        }
+    }
+    else {
+        for (size_t i = 0; i < count; ++i) {
+            S value;
+            memcpy(&value, source + i * sizeof(S), sizeof(S));
+            destination[i] = static_cast<D>(value);
+        }
+    }
+}
+
+/**
+ * Convierte un bloque de valores binarios al tipo D.
+ *
+ * @tparam D    Tipo de dato del destino.
+ * @param [in]  kind        Tipo de dato de los valores.
+ * @param [in]  source      Puntero a los datos.
+ * @param [in]  count       Número de valores a convertir.
+ * @param [out] destination Array donde se almacenan los valores.
+ * @param [in]  swap_bytes  Indica si hay que invertir el orden de los bytes.
+ **/
+template <typename D>
+void convertValues(ValueKind kind, const char* source, size_t count, D* destination, bool swap_bytes) {
+    switch (kind) {
+        case KIND_INT8   : convertBlock<int8_t, uint8_t>(source, count, destination, swap_bytes);    break;
+        case KIND_UINT8  : convertBlock<uint8_t, uint8_t>(source, count, destination, swap_bytes);   break;
+        case KIND_INT16  : convertBlock<int16_t, uint16_t>(source, count, destination, swap_bytes);  break;
+        case KIND_UINT16 : convertBlock<uint16_t, uint16_t>(source, count, destination, swap_bytes); break;
+        case KIND_INT32  : convertBlock<int32_t, uint32_t>(source, count, destination, swap_bytes);  break;
+        case KIND_UINT32 : convertBlock<uint32_t, uint32_t>(source, count, destination, swap_bytes); break;
+        case KIND_INT64  : convertBlock<int64_t, uint64_t>(source, count, destination, swap_bytes);  break;
+        case KIND_UINT64 : convertBlock<uint64_t, uint64_t>(source, count, destination, swap_bytes); break;
+        case KIND_FLOAT32: convertBlock<float, uint32_t>(source, count, destination, swap_bytes);    break;
+        case KIND_FLOAT64: convertBlock<double, uint64_t>(source, count, destination, swap_bytes);   break;
+        default          : std::fill(destination, destination + count, D());                        break;
+    }
+}
+
+#endif /* BINARYVALUES_H */
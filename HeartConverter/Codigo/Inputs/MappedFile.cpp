@@ -0,0 +1,57 @@
+/**
+ * @file MappedFile.cpp
+ *
+ * Clase que proyecta un fichero completo en memoria (mmap) en modo solo
+ * lectura. Las páginas se cargan bajo demanda y el sistema puede liberarlas
+ * cuando lo necesite, por lo que no ocupan memoria propia del programa.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#include "MappedFile.h"
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+/**
+ * Constructor. Abre el fichero y lo proyecta en memoria. Si no se puede abrir
+ * o esta vacio isOpen() devolverá false.
+ *
+ * @param [in]  file_name   Nombre del fichero.
+ **/
+MappedFile::MappedFile(const string& file_name) {
+    begin = nullptr;
+    length = 0;
+
+    int descriptor = open(file_name.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        return;
+
+    struct stat info;
+    if (fstat(descriptor, &info) == 0 && info.st_size > 0) {
+        void* address = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+        if (address != MAP_FAILED) {
+            madvise(address, info.st_size, MADV_SEQUENTIAL);
+            begin = static_cast<const char*>(address);
+            length = info.st_size;
+        }
+    }
+
+    //La proyección sigue siendo válida tras cerrar el descriptor.
+    close(descriptor);
+}
+
+/**
+ * Destructor. Elimina la proyección del fichero.
+ **/
+MappedFile::~MappedFile() {
+    if (begin != nullptr)
+        munmap(const_cast<char*>(begin), length);
+}
@@ -0,0 +1,55 @@
+/**
+ * @file MappedFile.h
+ *
+ * Clase que proyecta un fichero completo en memoria (mmap) en modo solo
+ * lectura. Las páginas se cargan bajo demanda y el sistema puede liberarlas
+ * cuando lo necesite, por lo que no ocupan memoria propia del programa.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+class MappedFile {
+public:
+    MappedFile(const std::string&);
+
+    /**
+     * Indica si el fichero se ha podido proyectar en memoria.
+     **/
+    bool isOpen() const {
+        return begin != nullptr;
+    }
+
+    /**
+     * Devuelve un puntero al primer byte del fichero.
+     **/
+    const char* data() const {
+        return begin;
+    }
+
+    /**
+     * Devuelve el tamaño del fichero en bytes.
+     **/
+    size_t size() const {
+        return length;
+    }
+
+    MappedFile(const MappedFile& orig) = delete;
+    MappedFile& operator=(const MappedFile& orig) = delete;
+    ~MappedFile();
+
+private:
+    const char* begin;  ///< Comienzo de la proyección, nullptr si no se ha podido abrir.
+    size_t length;      ///< Tamaño del fichero.
+};
+
+#endif /* MAPPEDFILE_H */
+
@@ -0,0 +1,1059 @@
+/**
+ * @file VtkLegacyReader.cpp
+ *
+ * Lector propio de ficheros VTK "legacy" en formato ASCII o BINARY. Proyecta
+ * el fichero en memoria, lo lee en una sola pasada y vuelca los puntos,
+ * elementos y atributos directamente en los conjuntos de datos, sin construir
+ * antes un vtkDataSet intermedio.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#include "VtkLegacyReader.h"
+#include "../Datasets/DatasetAbstract.h"
+#include "../Datasets/Dataset.h"
+#include "../Datasets/DatasetContext.h"
+#include "../Parallel.h"
+#include <vtkCellType.h>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+#include <cctype>
+#include <iostream>
+using namespace std;
+
+/**
+ * Traduce el nombre de un tipo de dato del fichero a ValueKind.
+ *
+ * @param [in]  type    Tipo de dato en el fichero.
+ * @return El tipo de dato o KIND_UNKNOWN si no esta soportado (string, etc).
+ **/
+static ValueKind getValueKind(const string& type) {
+    string lower_type;
+    for (auto c : type) {
+        lower_type += tolower(c);
+    }
+
+    if (lower_type == "bit")
+        return KIND_BIT;
+    else if (lower_type == "char" || lower_type == "signed_char")
+        return KIND_INT8;
+    else if (lower_type == "unsigned_char")
+        return KIND_UINT8;
+    else if (lower_type == "short")
+        return KIND_INT16;
+    else if (lower_type == "unsigned_short")
+        return KIND_UINT16;
+    else if (lower_type == "int" || lower_type == "vtkidtype" || lower_type == "vtktypeint32")
+        return KIND_INT32;
+    else if (lower_type == "unsigned_int" || lower_type == "vtktypeuint32")
+        return KIND_UINT32;
+    else if (lower_type == "long" || lower_type == "vtktypeint64")
+        return KIND_INT64;
+    else if (lower_type == "unsigned_long" || lower_type == "vtktypeuint64")
+        return KIND_UINT64;
+    else if (lower_type == "float")
+        return KIND_FLOAT32;
+    else if (lower_type == "double")
+        return KIND_FLOAT64;
+    else
+        return KIND_UNKNOWN;
+}
+
+static const size_t PARALLEL_VALUES = 1 << 16;  ///< Valores a partir de los que una sección ASCII se lee en paralelo.
+static const size_t CHUNK_SIZE = 1 << 20;       ///< Bytes aproximados de cada trozo leido en paralelo.
+static const size_t ROWS_BLOCK_VALUES = 1 << 16;///< Valores de cada bloque de filas que se añade de una vez.
+
+/**
+ * Indica si un carácter separa dos valores en una sección ASCII.
+ **/
+static inline bool isSeparator(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * Convierte un token ASCII al tipo T, redondeado antes al tipo de dato
+ * indicado. Los enteros se leen como enteros para no perder precisión. Los
+ * tokens que no son un número se leen como 0.
+ *
+ * @tparam T    Tipo de dato del resultado.
+ * @param [in]  token       Comienzo del token.
+ * @param [in]  token_end   Final del token.
+ * @param [in]  kind        Tipo de dato de la sección.
+ * @return El valor del token.
+ **/
+template <typename T>
+static T parseNumber(const char* token, const char* token_end, ValueKind kind) {
+    if (token < token_end && *token == '+')
+        ++token;
+
+    if (kind == KIND_FLOAT32 || kind == KIND_FLOAT64) {
+        double value = 0;
+        from_chars(token, token_end, value);
+        return (kind == KIND_FLOAT32) ? static_cast<T>(static_cast<float>(value)) : static_cast<T>(value);
+    }
+
+    if (kind == KIND_UINT64) {
+        unsigned long long value = 0;
+        from_chars(token, token_end, value);
+        return static_cast<T>(value);
+    }
+
+    long long value = 0;
+    from_chars(token, token_end, value);
+    return static_cast<T>(value);
+}
+
+/**
+ * Secuencia de valores de una sección de datos. Independientemente de que el
+ * fichero sea ASCII o BINARY devuelve los valores convertidos directamente al
+ * tipo T en el que se almacenan, redondeados antes al tipo declarado en el
+ * fichero. En BINARY los bytes se invierten por bloques en el tipo del
+ * fichero, sin pasar por double. En ASCII los bloques grandes se leen en
+ * paralelo directamente en su destino.
+ *
+ * @tparam T    Tipo de dato en el que se devuelven los valores.
+ **/
+template <typename T>
+class VtkLegacyReader::Values {
+public:
+
+    /**
+     * Constructor. En BINARY se salta el resto de la linea de cabecera y se
+     * reservan los bytes de la sección.
+     *
+     * @param [in]  reader  Lector del que se obtienen los datos.
+     * @param [in]  kind    Tipo de dato de la sección.
+     * @param [in]  count   Número de valores de la sección.
+     **/
+    Values(VtkLegacyReader& reader, ValueKind kind, size_t count) : reader(reader) {
+        this->kind = kind;
+        this->remaining = count;
+        this->consumed = 0;
+        this->index = 0;
+        this->available = 0;
+        this->data = nullptr;
+
+        if (!reader.is_ascii) {
+            size_t bytes = (kind == KIND_BIT) ? (count + 7) / 8 : count * getValueSize(kind);
+            data = reader.binaryData(bytes);
+        }
+    }
+
+    /**
+     * Devuelve el siguiente valor de la sección.
+     **/
+    T next() {
+        if (index == available) {
+            index = 0;
+            available = min(remaining, BLOCK_SIZE);
+
+            //Se piden más valores de los declarados, el fichero es incorrecto.
+            if (available == 0)
+                return T();
+
+            convert(values, available);
+        }
+        return values[index++];
+    }
+
+    /**
+     * Copia los siguientes valores de la sección en un array. Si se piden
+     * más valores de los que quedan el resto se rellenan con 0.
+     *
+     * @param [out] destination Array donde se almacenan los valores.
+     * @param [in]  amount      Número de valores a copiar.
+     **/
+    void read(T* destination, size_t amount) {
+        size_t buffered = min(amount, available - index);
+        copy(values + index, values + index + buffered, destination);
+        index += buffered;
+
+        size_t converted = min(amount - buffered, remaining);
+        convert(destination + buffered, converted);
+        fill(destination + buffered + converted, destination + amount, T());
+    }
+
+    /**
+     * Añade las siguientes filas de la sección a un conj. de datos. En ASCII
+     * las filas se añaden vacías y los valores se leen directamente sobre
+     * ellas. En BINARY, o si el conj. de datos no admite filas vacías, los
+     * valores se convierten por bloques de filas al tipo del conj. de datos
+     * y cada bloque se añade de una vez.
+     *
+     * @param [in,out]  dataset     Conj. de datos, con valores de tipo T.
+     * @param [in]      rows        Número de filas.
+     * @param [in]      row_size    Número de valores de cada fila.
+     **/
+    void append(DatasetAbstract* dataset, size_t rows, unsigned int row_size) {
+        if (reader.is_ascii) {
+            void* rows_data = dataset->addEmptyRows(sizeof(T), rows, row_size);
+            if (rows_data != nullptr) {
+                read(static_cast<T*>(rows_data), rows * row_size);
+                return;
+            }
+        }
+
+        size_t block_rows = max<size_t>(1, ROWS_BLOCK_VALUES / max(1u, row_size));
+        vector<T> block(min(rows, block_rows) * row_size);
+
+        for (size_t first = 0; first < rows; first += block_rows) {
+            size_t amount = min(block_rows, rows - first);
+            read(block.data(), amount * row_size);
+            dataset->addRawData(block.data(), sizeof(T), amount, row_size);
+        }
+    }
+
+private:
+    static constexpr size_t BLOCK_SIZE = 4096;
+
+    VtkLegacyReader& reader;    ///< Lector del que se obtienen los datos.
+    ValueKind kind;             ///< Tipo de dato de la sección.
+    const char* data;           ///< Datos BINARY pendientes de convertir.
+    size_t remaining;           ///< Valores pendientes de convertir.
+    size_t consumed;            ///< Valores ya convertidos.
+    size_t index;               ///< Siguiente valor a devolver del bloque.
+    size_t available;           ///< Valores disponibles en el bloque.
+    T values[BLOCK_SIZE];       ///< Bloque de valores convertidos para next().
+
+    void convert(T*, size_t);
+};
+
+/**
+ * Convierte los siguientes valores de la sección.
+ *
+ * @param [out] destination Array donde se almacenan los valores.
+ * @param [in]  amount      Número de valores, como mucho los que quedan.
+ **/
+template <typename T>
+void VtkLegacyReader::Values<T>::convert(T* destination, size_t amount) {
+    if (reader.is_ascii && amount >= PARALLEL_VALUES) {
+        reader.parseAsciiValues(kind, amount, destination);
+    }
+    else if (reader.is_ascii) {
+        for (size_t i = 0; i < amount; ++i) {
+            size_t token_length;
+            const char* token = reader.nextToken(token_length);
+            destination[i] = (token == nullptr) ? T() : parseNumber<T>(token, token + token_length, kind);
+        }
+    }
+    else if (data == nullptr) {
+        fill(destination, destination + amount, T());
+    }
+    else if (kind == KIND_BIT) {
+        for (size_t i = 0; i < amount; ++i) {
+            size_t bit = consumed + i;
+            destination[i] = (static_cast<unsigned char>(data[bit / 8]) >> (7 - bit % 8)) & 1;
+        }
+    }
+    else {
+        const char* block = data + consumed * getValueSize(kind);
+        convertValues(kind, block, amount, destination, !isBigEndianHost());
+    }
+
+    remaining -= amount;
+    consumed += amount;
+}
+
+/**
+ * Constructor. Proyecta el fichero en memoria y lee su cabecera para saber si
+ * este lector es capaz de interpretarlo.
+ *
+ * @param [in]  file_name   Nombre del fichero de entrada.
+ * @param [in]  context     Contexto en el que se crean los conj. de datos.
+ **/
+VtkLegacyReader::VtkLegacyReader(const string& file_name, DatasetContext& context)
+    : AbstractReader(context), file(file_name) {
+    cursor = file.data();
+    end = file.data() + file.size();
+    is_ascii = false;
+    attributes_size = 0;
+    elements = nullptr;
+    primitives = nullptr;
+
+    if (file.isOpen()) {
+        readHeader();
+    }
+}
+
+/**
+ * Indica si el fichero es un VTK "legacy" que este lector sabe interpretar,
+ * esto es, de tipo POLYDATA o UNSTRUCTURED_GRID.
+ *
+ * @return true si el fichero puede ser leido, false en caso contrario.
+ **/
+bool VtkLegacyReader::isSupported() {
+    return file.isOpen() &&
+           (dataset_type == "POLYDATA" || dataset_type == "UNSTRUCTURED_GRID");
+}
+
+/**
+ * Lee el resto del fichero y crea los conj. de datos "points", "elements",
+ * "primitives" y los de los arrays de atributos indicados. Los elementos se
+ * añaden en el orden en el que aparecen en el fichero, que es el mismo que usa
+ * VTK (vértices, lineas, polígonos y tiras de triángulos). El resto de arrays
+ * se saltan y se recuerda donde comienzan.
+ *
+ * @param [in]  arrays  Nombres de los arrays que se leen inmediatamente.
+ **/
+void VtkLegacyReader::read(const vector<string>& arrays) {
+    string keyword;
+    requested_arrays = arrays;
+    bool has_points = false;
+
+    while (!(keyword = nextKeyword()).empty()) {
+
+        if (keyword == "POINTS") {
+            size_t size = readInteger();
+            readPoints(size, nextWord());
+            has_points = true;
+        }
+        else if (keyword == "CELLS") {
+            size_t size = readInteger();
+            size_t total = readInteger();
+            readCells(size, total, -1);
+        }
+        else if (keyword == "VERTICES" || keyword == "LINES" ||
+                 keyword == "POLYGONS" || keyword == "TRIANGLE_STRIPS") {
+            int kind = VTK_VERTEX;
+            if (keyword == "LINES")
+                kind = VTK_LINE;
+            else if (keyword == "POLYGONS")
+                kind = VTK_POLYGON;
+            else if (keyword == "TRIANGLE_STRIPS")
+                kind = VTK_TRIANGLE_STRIP;
+
+            size_t size = readInteger();
+            size_t total = readInteger();
+            readCells(size, total, kind);
+        }
+        else if (keyword == "CELL_TYPES") {
+            readCellTypes(readInteger());
+        }
+        else if (keyword == "POINT_DATA" || keyword == "CELL_DATA") {
+            attributes_size = readInteger();
+        }
+        else if (keyword == "SCALARS") {
+            string name = decodeName(nextWord());
+            string type = nextWord();
+            string rest;
+            nextLine(rest);
+            int components = atoi(rest.c_str());
+            if (components <= 0)
+                components = 1;
+
+            if (nextIs("LOOKUP_TABLE"))
+                nextWord();
+
+            readArray(name, type, attributes_size, components);
+        }
+        else if (keyword == "COLOR_SCALARS") {
+            string name = decodeName(nextWord());
+            readColorScalars(name, readInteger());
+        }
+        else if (keyword == "VECTORS" || keyword == "NORMALS") {
+            string name = decodeName(nextWord());
+            readArray(name, nextWord(), attributes_size, 3);
+        }
+        else if (keyword == "TENSORS" || keyword == "TENSORS6") {
+            string name = decodeName(nextWord());
+            readArray(name, nextWord(), attributes_size, (keyword == "TENSORS") ? 9 : 6);
+        }
+        else if (keyword == "TEXTURE_COORDINATES") {
+            string name = decodeName(nextWord());
+            int dimension = readInteger();
+            readArray(name, nextWord(), attributes_size, dimension);
+        }
+        else if (keyword == "GLOBAL_IDS" || keyword == "PEDIGREE_IDS") {
+            string name = decodeName(nextWord());
+            readArray(name, nextWord(), attributes_size, 1);
+        }
+        else if (keyword == "LOOKUP_TABLE") {
+            nextWord();
+            skipLookupTable(readInteger());
+        }
+        else if (keyword == "FIELD") {
+            readField();
+        }
+        else if (keyword == "METADATA") {
+            skipMetadata();
+        }
+        else {
+            cout << "Palabra clave " << keyword << " no reconocida en el fichero VTK." << endl;
+            break;
+        }
+    }
+
+    //Aunque el fichero no tenga puntos o elementos se crean vacios igual que
+    //hacia VtkParser con el lector de VTK.
+    if (!has_points)
+        context.createDataset("double", "points", 0);
+    createCellDatasets(0);
+}
+
+/**
+ * Lee un array que se saltó en read(). El cursor vuelve a la posición en la
+ * que comienzan sus valores y después se restaura.
+ *
+ * @param [in]  name    Nombre del array.
+ * @return true si el array existe en el fichero y se ha creado.
+ **/
+bool VtkLegacyReader::loadArray(const string& name) {
+    for (const auto& array : lazy_arrays) {
+        if (array.name != name)
+            continue;
+
+        const char* saved_cursor = cursor;
+        cursor = array.position;
+        if (array.is_color)
+            createColorScalars(array.name, array.tuples, array.components);
+        else
+            createArray(array.name, array.type, array.tuples, array.components);
+        cursor = saved_cursor;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * Lee la cabecera del fichero: la versión, el título, el formato de los datos
+ * (ASCII/BINARY) y el tipo de conj. de datos.
+ **/
+void VtkLegacyReader::readHeader() {
+    string line;
+
+    nextLine(line);
+    if (line.compare(0, 14, "# vtk DataFile") != 0) {
+        return;
+    }
+    nextLine(line); //Título
+
+    string format = nextKeyword();
+    if (format != "ASCII" && format != "BINARY") {
+        return;
+    }
+    is_ascii = (format == "ASCII");
+
+    if (nextKeyword() == "DATASET") {
+        dataset_type = nextKeyword();
+    }
+}
+
+/**
+ * Lee las coordenadas de los puntos. Los valores se redondean al tipo indicado
+ * en el fichero antes de almacenarse, igual que hace VTK.
+ *
+ * @param [in]  size    Número de puntos.
+ * @param [in]  type    Tipo de dato de las coordenadas en el fichero.
+ **/
+void VtkLegacyReader::readPoints(size_t size, const string& type) {
+    DatasetAbstract* points = context.createDataset("double", "points", size);
+
+    Values<double> values(*this, getValueKind(type), size * 3);
+    values.append(points, size, 3);
+}
+
+/**
+ * Lee una sección de elementos. Admite tanto el formato clásico (número de
+ * índices seguido de los índices) como el de la versión 5 (OFFSETS seguido de
+ * CONNECTIVITY). Los índices se leen de una vez en un único array y los
+ * elementos seguidos con el mismo número de puntos se añaden juntos.
+ *
+ * @param [in]  size    Número de elementos (o de offsets en la versión 5).
+ * @param [in]  total   Número total de enteros de la sección (o de índices en
+ *                      la versión 5).
+ * @param [in]  kind    Tipo de sección de POLYDATA (VTK_VERTEX, VTK_LINE,
+ *                      VTK_POLYGON o VTK_TRIANGLE_STRIP) o -1 si se trata de la
+ *                      sección CELLS de un UNSTRUCTURED_GRID.
+ **/
+void VtkLegacyReader::readCells(size_t size, size_t total, int kind) {
+
+    if (nextIs("OFFSETS")) {
+        vector<size_t> offsets(size);
+        {
+            Values<size_t> values(*this, getValueKind(nextWord()), size);
+            values.read(offsets.data(), size);
+        }
+
+        size_t cells = (size > 0) ? size - 1 : 0;
+        vector<size_t> points_amount(cells);
+        size_t needed = 0;
+        for (size_t i = 0; i < cells; ++i) {
+            points_amount[i] = (offsets[i+1] > offsets[i]) ? offsets[i+1] - offsets[i] : 0;
+            needed += points_amount[i];
+        }
+
+        //Si los offsets piden más índices de los que hay, los que faltan son 0
+        nextWord(); //CONNECTIVITY
+        vector<unsigned int> connectivity(max(total, needed));
+        {
+            Values<unsigned int> values(*this, getValueKind(nextWord()), total);
+            values.read(connectivity.data(), total);
+        }
+
+        createCellDatasets(cells);
+        size_t run_begin = 0;
+        size_t position = 0;
+        for (size_t i = 0, run_cells = 0; i <= cells; ++i) {
+            if (run_cells > 0 && (i == cells || points_amount[i] != points_amount[i-1])) {
+                addElements(connectivity.data() + run_begin, run_cells, points_amount[i-1], kind);
+                run_begin = position;
+                run_cells = 0;
+            }
+            if (i < cells) {
+                position += points_amount[i];
+                ++run_cells;
+            }
+        }
+        return;
+    }
+
+    vector<unsigned int> section(total);
+    {
+        Values<unsigned int> values(*this, KIND_INT32, total);
+        values.read(section.data(), total);
+    }
+
+    //Los índices de cada elemento se compactan sobre la propia sección
+    //quitando el número de índices, así los elementos seguidos del mismo
+    //tamaño quedan contiguos. La escritura nunca adelanta a la lectura.
+    createCellDatasets(size);
+    size_t run_begin = 0;
+    size_t run_cells = 0;
+    size_t run_size = 0;
+    size_t written = 0;
+    size_t position = 0;
+    for (size_t i = 0; i < size; ++i) {
+        size_t points_amount = (position < section.size()) ? section[position] : 0;
+        ++position;
+
+        if (run_cells > 0 && points_amount != run_size) {
+            addElements(section.data() + run_begin, run_cells, run_size, kind);
+            run_begin = written;
+            run_cells = 0;
+        }
+
+        //Fichero incorrecto, los índices que faltan son 0
+        if (position + points_amount > section.size())
+            section.resize(position + points_amount, 0);
+
+        copy(section.begin() + position, section.begin() + position + points_amount, section.begin() + written);
+        position += points_amount;
+        written += points_amount;
+        run_size = points_amount;
+        ++run_cells;
+    }
+    addElements(section.data() + run_begin, run_cells, run_size, kind);
+}
+
+/**
+ * Añade de una vez varios elementos seguidos con el mismo número de puntos y,
+ * si se trata de un POLYDATA, su tipo de primitiva.
+ *
+ * @param [in]  ids             Índices de los puntos de los elementos.
+ * @param [in]  cells           Número de elementos.
+ * @param [in]  points_amount   Número de puntos de cada elemento.
+ * @param [in]  kind            Sección de POLYDATA o -1 en UNSTRUCTURED_GRID.
+ **/
+void VtkLegacyReader::addElements(const unsigned int* ids, size_t cells, size_t points_amount, int kind) {
+    if (cells == 0)
+        return;
+
+    elements->addRawData(ids, sizeof(unsigned int), cells, points_amount);
+
+    if (kind != -1) {
+        run_primitives.assign(cells, getPolyCellType(kind, points_amount));
+        primitives->addRawData(run_primitives.data(), sizeof(unsigned short), cells, 1);
+    }
+}
+
+/**
+ * Lee el tipo de primitiva de cada elemento de un UNSTRUCTURED_GRID.
+ *
+ * @param [in]  size    Número de elementos.
+ **/
+void VtkLegacyReader::readCellTypes(size_t size) {
+    createCellDatasets(size);
+
+    Values<unsigned short> values(*this, KIND_INT32, size);
+    values.append(primitives, size, 1);
+}
+
+/**
+ * Lee un array de atributos si se ha pedido o, si no, lo salta recordando
+ * donde comienza. Si el tipo no esta soportado (por ejemplo string) el array
+ * se salta sin más.
+ *
+ * @param [in]  name        Nombre del array.
+ * @param [in]  type        Tipo de dato en el fichero.
+ * @param [in]  tuples      Número de tuplas.
+ * @param [in]  components  Número de componentes de cada tupla.
+ **/
+void VtkLegacyReader::readArray(const string& name, const string& type, size_t tuples, int components) {
+    if (legacyTypeToNative(type).empty()) {
+        if (!is_ascii) {
+            cout << "El array " << name << " de tipo " << type << " no esta soportado en ficheros BINARY." << endl;
+            cursor = end;
+            return;
+        }
+
+        //Cada string ocupa una linea propia.
+        skipLine();
+        for (size_t i = 0; i < tuples * components; ++i) {
+            skipLine();
+        }
+        return;
+    }
+
+    if (isRequested(name)) {
+        createArray(name, type, tuples, components);
+    }
+    else {
+        lazy_arrays.push_back({name, type, tuples, components, false, cursor});
+        skipValues(getValueKind(type), tuples * components);
+    }
+}
+
+/**
+ * Lee los valores de un array de atributos y lo almacena con su nombre y su
+ * tipo de dato nativo.
+ *
+ * @param [in]  name        Nombre del array.
+ * @param [in]  type        Tipo de dato en el fichero.
+ * @param [in]  tuples      Número de tuplas.
+ * @param [in]  components  Número de componentes de cada tupla.
+ **/
+void VtkLegacyReader::createArray(const string& name, const string& type, size_t tuples, int components) {
+    DatasetAbstract* array_dataset = context.createDataset(legacyTypeToNative(type), name, tuples);
+
+    if (array_dataset == nullptr) {
+        skipValues(getValueKind(type), tuples * components);
+        return;
+    }
+
+    visitDataset(array_dataset, [&](auto& typed) {
+        using value_type = typename remove_reference<decltype(typed)>::type::stored_type;
+
+        Values<value_type> values(*this, getValueKind(type), tuples * components);
+        values.append(array_dataset, tuples, components);
+    });
+}
+
+/**
+ * Lee un array COLOR_SCALARS si se ha pedido o, si no, lo salta recordando
+ * donde comienza.
+ *
+ * @param [in]  name        Nombre del array.
+ * @param [in]  components  Número de componentes de cada color.
+ **/
+void VtkLegacyReader::readColorScalars(const string& name, int components) {
+    if (isRequested(name)) {
+        createColorScalars(name, attributes_size, components);
+    }
+    else {
+        lazy_arrays.push_back({name, "", attributes_size, components, true, cursor});
+        skipValues(is_ascii ? KIND_FLOAT32 : KIND_UINT8, attributes_size * components);
+    }
+}
+
+/**
+ * Lee los valores de un array COLOR_SCALARS. En ASCII los colores se escriben
+ * como reales entre 0 y 1 y en BINARY como "unsigned char". En ambos casos se
+ * almacenan como "unsigned char", igual que hace VTK.
+ *
+ * @param [in]  name        Nombre del array.
+ * @param [in]  tuples      Número de colores.
+ * @param [in]  components  Número de componentes de cada color.
+ **/
+void VtkLegacyReader::createColorScalars(const string& name, size_t tuples, int components) {
+    DatasetAbstract* array_dataset = context.createDataset("unsigned char", name, tuples);
+
+    if (!is_ascii) {
+        Values<unsigned char> values(*this, KIND_UINT8, tuples * components);
+        values.append(array_dataset, tuples, components);
+        return;
+    }
+
+    Values<float> values(*this, KIND_FLOAT32, tuples * components);
+
+    size_t block_tuples = max<size_t>(1, ROWS_BLOCK_VALUES / max(1, components));
+    vector<float> colors(min(tuples, block_tuples) * components);
+    vector<unsigned char> block(colors.size());
+    for (size_t first = 0; first < tuples; first += block_tuples) {
+        size_t amount = min(block_tuples, tuples - first);
+        values.read(colors.data(), amount * components);
+        for (size_t i = 0; i < amount * components; ++i) {
+            block[i] = static_cast<unsigned char>(colors[i] * 255.0 + 0.5);
+        }
+        array_dataset->addRawData(block.data(), sizeof(unsigned char), amount, components);
+    }
+}
+
+/**
+ * Indica si un array se ha pedido en read().
+ *
+ * @param [in]  name    Nombre del array.
+ **/
+bool VtkLegacyReader::isRequested(const string& name) {
+    return find(requested_arrays.begin(), requested_arrays.end(), name) != requested_arrays.end();
+}
+
+/**
+ * Salta los valores de una sección sin convertirlos.
+ *
+ * @param [in]  kind    Tipo de dato de la sección.
+ * @param [in]  count   Número de valores.
+ **/
+void VtkLegacyReader::skipValues(ValueKind kind, size_t count) {
+    if (!is_ascii) {
+        binaryData((kind == KIND_BIT) ? (count + 7) / 8 : count * getValueSize(kind));
+        return;
+    }
+
+    size_t token_length;
+    for (size_t i = 0; i < count; ++i) {
+        if (nextToken(token_length) == nullptr)
+            break;
+    }
+}
+
+/**
+ * Lee una sección FIELD con todos sus arrays.
+ **/
+void VtkLegacyReader::readField() {
+    nextWord(); //Nombre del FIELD
+    long long arrays_amount = readInteger();
+
+    for (long long i = 0; i < arrays_amount; ++i) {
+        string name = nextWord();
+        if (name == "NULL_ARRAY")
+            continue;
+
+        int components = readInteger();
+        size_t tuples = readInteger();
+        string type = nextWord();
+
+        readArray(decodeName(name), type, tuples, components);
+
+        if (nextIs("METADATA"))
+            skipMetadata();
+    }
+}
+
+/**
+ * Salta una tabla de colores (4 valores por entrada).
+ *
+ * @param [in]  size    Número de entradas de la tabla.
+ **/
+void VtkLegacyReader::skipLookupTable(size_t size) {
+    skipValues(is_ascii ? KIND_FLOAT32 : KIND_UINT8, size * 4);
+}
+
+/**
+ * Salta un bloque METADATA, que termina con una linea en blanco.
+ **/
+void VtkLegacyReader::skipMetadata() {
+    string line;
+
+    skipLine();
+    while (nextLine(line)) {
+        if (line.find_first_not_of(" \t\r") == string::npos)
+            break;
+    }
+}
+
+/**
+ * Lee en paralelo los siguientes valores ASCII del fichero. Primero se divide
+ * el fichero en trozos que comienzan tras un salto de linea y se cuentan los
+ * tokens de cada uno, así cada trozo sabe en que posición del resultado debe
+ * escribir. Después se convierten los trozos necesarios a la vez. Como no se
+ * sabe de antemano donde termina la sección, los trozos se cuentan por
+ * ventanas que se agrandan hasta tener suficientes tokens.
+ *
+ * Cada trozo escribe sus valores directamente en su parte del destino.
+ *
+ * @tparam T    Tipo de dato del destino.
+ * @param [in]  kind    Tipo de dato de la sección.
+ * @param [in]  count   Número de valores a leer.
+ * @param [out] values  Array de count valores donde se almacenan. Si el
+ *                      fichero termina antes los valores que faltan son 0.
+ **/
+template <typename T>
+void VtkLegacyReader::parseAsciiValues(ValueKind kind, size_t count, T* values) {
+    vector<const char*> chunks;         //Comienzo de cada trozo
+    vector<size_t> first_token(1, 0);   //Tokens anteriores a cada trozo
+
+    const char* scanned = cursor;
+    size_t window = count * 4;
+    while (first_token.back() < count && scanned < end) {
+        const char* window_end = scanned + min<size_t>(window, end - scanned);
+        window *= 2;
+
+        size_t new_chunks = chunks.size();
+        while (scanned < window_end) {
+            chunks.push_back(scanned);
+            const char* chunk_end = scanned + min<size_t>(CHUNK_SIZE, end - scanned);
+            const char* new_line = static_cast<const char*>(memchr(chunk_end, '\n', end - chunk_end));
+            scanned = (new_line != nullptr) ? new_line + 1 : end;
+        }
+
+        vector<size_t> tokens(chunks.size() - new_chunks);
+        parallelFor(tokens.size(), [&](size_t i) {
+            const char* p = chunks[new_chunks + i];
+            const char* chunk_end = (new_chunks + i + 1 < chunks.size()) ? chunks[new_chunks + i + 1] : scanned;
+            bool in_token = false;
+            for (; p < chunk_end; ++p) {
+                bool is_token = !isSeparator(*p);
+                tokens[i] += is_token && !in_token;
+                in_token = is_token;
+            }
+        });
+
+        for (auto chunk_tokens : tokens) {
+            first_token.push_back(first_token.back() + chunk_tokens);
+        }
+    }
+    chunks.push_back(scanned);
+
+    //Solo se convierten los trozos que contienen valores de la sección
+    size_t used_chunks = 0;
+    while (used_chunks + 1 < first_token.size() && first_token[used_chunks] < count)
+        ++used_chunks;
+
+    fill(values + min(count, first_token[used_chunks]), values + count, T());
+    vector<const char*> chunk_cursor(used_chunks);
+    parallelFor(used_chunks, [&](size_t i) {
+        const char* p = chunks[i];
+        const char* chunk_end = chunks[i+1];
+        size_t index = first_token[i];
+
+        while (index < count) {
+            while (p < chunk_end && isSeparator(*p))
+                ++p;
+            if (p == chunk_end)
+                break;
+
+            const char* token = p;
+            while (p < chunk_end && !isSeparator(*p))
+                ++p;
+            values[index++] = parseNumber<T>(token, p, kind);
+        }
+        chunk_cursor[i] = p;
+    });
+
+    if (used_chunks > 0)
+        cursor = chunk_cursor[used_chunks - 1];
+}
+
+/**
+ * Crea los conj. de datos "elements" y "primitives" si todavía no existen.
+ *
+ * @param [in]  size    Cantidad de elementos a reservar.
+ **/
+void VtkLegacyReader::createCellDatasets(size_t size) {
+    if (elements == nullptr) {
+        elements = context.createDataset("unsigned int", "elements", size);
+        primitives = context.createDataset("unsigned short", "primitives", size);
+    }
+}
+
+/**
+ * Avanza hasta el siguiente token (secuencia de carácteres sin espacios).
+ *
+ * @param [out] token_length    Longitud del token.
+ * @return Puntero al comienzo del token o nullptr si se ha llegado al final
+ *         del fichero.
+ **/
+const char* VtkLegacyReader::nextToken(size_t& token_length) {
+    while (cursor < end && isspace(static_cast<unsigned char>(*cursor)))
+        ++cursor;
+
+    if (cursor == end)
+        return nullptr;
+
+    const char* token = cursor;
+    while (cursor < end && !isspace(static_cast<unsigned char>(*cursor)))
+        ++cursor;
+
+    token_length = cursor - token;
+    return token;
+}
+
+/**
+ * Devuelve el siguiente token en mayúsculas. Las palabras clave de VTK no
+ * distinguen entre mayúsculas y minúsculas.
+ *
+ * @return La palabra clave o un string vacio al final del fichero.
+ **/
+string VtkLegacyReader::nextKeyword() {
+    string keyword = nextWord();
+    for (auto& c : keyword) {
+        c = toupper(c);
+    }
+    return keyword;
+}
+
+/**
+ * Devuelve el siguiente token tal y como aparece en el fichero.
+ *
+ * @return El token o un string vacio al final del fichero.
+ **/
+string VtkLegacyReader::nextWord() {
+    size_t token_length;
+    const char* token = nextToken(token_length);
+    if (token == nullptr)
+        return "";
+    return string(token, token_length);
+}
+
+/**
+ * Comprueba si el siguiente token es la palabra clave indicada. Si lo es la
+ * consume, si no deja el fichero tal y como estaba.
+ *
+ * @param [in]  keyword Palabra clave en mayúsculas.
+ * @return true si el siguiente token es la palabra clave.
+ **/
+bool VtkLegacyReader::nextIs(const char* keyword) {
+    const char* saved_cursor = cursor;
+    size_t keyword_length = strlen(keyword);
+
+    size_t token_length;
+    const char* token = nextToken(token_length);
+    if (token != nullptr && token_length == keyword_length &&
+        strncasecmp(token, keyword, keyword_length) == 0) {
+        return true;
+    }
+
+    cursor = saved_cursor;
+    return false;
+}
+
+/**
+ * Descarta lo que queda de la linea actual.
+ **/
+void VtkLegacyReader::skipLine() {
+    const char* new_line = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+    cursor = (new_line != nullptr) ? new_line + 1 : end;
+}
+
+/**
+ * Lee lo que queda de la linea actual, sin el salto de linea.
+ *
+ * @param [out] line    String donde se almacena la linea.
+ * @return false si se ha llegado al final del fichero sin leer nada.
+ **/
+bool VtkLegacyReader::nextLine(string& line) {
+    if (cursor == end) {
+        line.clear();
+        return false;
+    }
+
+    const char* line_begin = cursor;
+    skipLine();
+
+    const char* line_end = cursor;
+    if (line_end > line_begin && line_end[-1] == '\n')
+        --line_end;
+    if (line_end > line_begin && line_end[-1] == '\r')
+        --line_end;
+
+    line.assign(line_begin, line_end);
+    return true;
+}
+
+/**
+ * Devuelve un puntero a una sección BINARY y avanza el cursor hasta su final.
+ * Los datos comienzan en la linea siguiente a la cabecera de la sección.
+ *
+ * @param [in]  bytes   Tamaño de la sección.
+ * @return Puntero a los datos o nullptr si el fichero es demasiado corto.
+ **/
+const char* VtkLegacyReader::binaryData(size_t bytes) {
+    if (cursor > file.data() && cursor[-1] != '\n')
+        skipLine();
+
+    if (static_cast<size_t>(end - cursor) < bytes) {
+        cout << "El fichero VTK esta incompleto." << endl;
+        cursor = end;
+        return nullptr;
+    }
+
+    const char* data = cursor;
+    cursor += bytes;
+    return data;
+}
+
+/**
+ * Lee el siguiente token como un número entero.
+ **/
+long long VtkLegacyReader::readInteger() {
+    size_t token_length;
+    const char* token = nextToken(token_length);
+    if (token == nullptr)
+        return 0;
+
+    return parseNumber<long long>(token, token + token_length, KIND_INT64);
+}
+
+/**
+ * Traduce el nombre de un tipo de dato de un fichero VTK "legacy" al tipo
+ * nativo de c++ que entiende DatasetContext::createDataset.
+ *
+ * @param [in]  type    Tipo de dato en el fichero.
+ * @return El tipo nativo o un string vacio si no esta soportado.
+ **/
+string VtkLegacyReader::legacyTypeToNative(const string& type) {
+    if (strcasecmp(type.c_str(), "char") == 0)
+        return "char";
+    else if (strcasecmp(type.c_str(), "vtkIdType") == 0)
+        return "int64_t";
+
+    switch (getValueKind(type)) {
+        case KIND_BIT    : return "bool";
+        case KIND_INT8   : return "signed char";
+        case KIND_UINT8  : return "unsigned char";
+        case KIND_INT16  : return "short";
+        case KIND_UINT16 : return "unsigned short";
+        case KIND_INT32  : return "int";
+        case KIND_UINT32 : return "unsigned int";
+        case KIND_INT64  : return "int64_t";
+        case KIND_UINT64 : return "uint64_t";
+        case KIND_FLOAT32: return "float";
+        case KIND_FLOAT64: return "double";
+        default          : return "";
+    }
+}
+
+/**
+ * Los nombres de los arrays en VTK codifican los carácteres especiales como
+ * %XX (por ejemplo %20 para el espacio). Esta función los decodifica.
+ *
+ * @param [in]  name    Nombre tal y como aparece en el fichero.
+ * @return El nombre decodificado.
+ **/
+string VtkLegacyReader::decodeName(const string& name) {
+    string decoded;
+
+    for (size_t i = 0; i < name.size(); ++i) {
+        if (name[i] == '%' && i + 2 < name.size() &&
+            isxdigit(static_cast<unsigned char>(name[i+1])) &&
+            isxdigit(static_cast<unsigned char>(name[i+2]))) {
+            decoded += static_cast<char>(strtol(name.substr(i + 1, 2).c_str(), nullptr, 16));
+            i += 2;
+        }
+        else {
+            decoded += name[i];
+        }
+    }
+
+    return decoded;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file VtkLegacyReader.h
+ *
+ * Lector propio de ficheros VTK "legacy" en formato ASCII o BINARY. Proyecta
+ * el fichero en memoria, lo lee en una sola pasada y vuelca los puntos,
+ * elementos y atributos directamente en los conjuntos de datos, sin construir
+ * antes un vtkDataSet intermedio.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#ifndef VTKLEGACYREADER_H
+#define VTKLEGACYREADER_H
+
+#include "AbstractReader.h"
+#include "BinaryValues.h"
+#include "MappedFile.h"
+#include <string>
+#include <vector>
+
+class DatasetAbstract;
+
+class VtkLegacyReader : public AbstractReader {
+public:
+    VtkLegacyReader(const std::string&, DatasetContext&);
+
+    bool isSupported();
+    void read(const std::vector<std::string>&);
+    bool loadArray(const std::string&);
+
+private:
+    template <typename T> class Values;
+
+    /**
+     * Array de atributos que no se ha leido todavía.
+     **/
+    typedef struct LazyArray {
+        std::string name;           ///< Nombre del array.
+        std::string type;           ///< Tipo de dato en el fichero.
+        size_t tuples;              ///< Número de tuplas.
+        int components;             ///< Número de componentes de cada tupla.
+        bool is_color;              ///< Indica si se trata de un array COLOR_SCALARS.
+        const char* position;       ///< Posición del fichero en la que comienzan sus valores.
+    } LazyArray;
+
+    MappedFile file;            ///< Fichero de entrada proyectado en memoria.
+    const char* cursor;         ///< Posición del siguiente carácter a leer.
+    const char* end;            ///< Final del fichero.
+
+    std::string dataset_type;   ///< Tipo de conj. de datos (POLYDATA, UNSTRUCTURED_GRID...).
+    bool is_ascii;              ///< Indica si los datos estan en formato ASCII.
+    size_t attributes_size;     ///< Cantidad de tuplas de la sección POINT_DATA/CELL_DATA actual.
+
+    DatasetAbstract* elements;  ///< Índices de los puntos de cada elemento.
+    DatasetAbstract* primitives;///< Tipo de primitiva de cada elemento.
+    std::vector<unsigned short> run_primitives; ///< Primitivas de un tramo de elementos, reutilizado entre tramos.
+
+    std::vector<std::string> requested_arrays;  ///< Arrays que se leen inmediatamente.
+    std::vector<LazyArray> lazy_arrays;         ///< Arrays que se leerán bajo demanda.
+
+    const char* nextToken(size_t&);
+    std::string nextKeyword();
+    std::string nextWord();
+    bool nextIs(const char*);
+    void skipLine();
+    bool nextLine(std::string&);
+    const char* binaryData(size_t);
+
+    long long readInteger();
+    template <typename T> void parseAsciiValues(ValueKind, size_t, T*);
+
+    void readHeader();
+    void readPoints(size_t, const std::string&);
+    void readCells(size_t, size_t, int);
+    void readCellTypes(size_t);
+    void readArray(const std::string&, const std::string&, size_t, int);
+    void readColorScalars(const std::string&, int);
+    void createArray(const std::string&, const std::string&, size_t, int);
+    void createColorScalars(const std::string&, size_t, int);
+    bool isRequested(const std::string&);
+    void skipValues(ValueKind, size_t);
+    void readField();
+    void skipLookupTable(size_t);
+    void skipMetadata();
+    void createCellDatasets(size_t);
+    void addElements(const unsigned int*, size_t, size_t, int);
+
+    static std::string legacyTypeToNative(const std::string&);
+    static std::string decodeName(const std::string&);
+};
+
+#endif /* VTKLEGACYREADER_H */
+
@@ -0,0 +1,800 @@
+/**
+ * @file VtkXmlReader.cpp
+ *
+ * Lector propio de ficheros VTK XML de tipo UnstructuredGrid (.vtu) y
+ * PolyData (.vtp). Admite datos en ASCII, en base64 y "appended" (raw o
+ * base64), con o sin compresión zlib. Los bloques comprimidos son
+ * independientes y se descomprimen en paralelo.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#include "VtkXmlReader.h"
+#include "../Datasets/DatasetAbstract.h"
+#include "../Datasets/DatasetContext.h"
+#include "../Parallel.h"
+#include <vtkCellType.h>
+#include <zlib.h>
+
+#include <string>
+#include <vector>
+#include <map>
+#include <atomic>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cctype>
+#include <iostream>
+using namespace std;
+
+static const size_t BASE64_CHUNK = 1 << 22;    ///< Carácteres base64 que decodifica cada tarea.
+static const size_t ROWS_BLOCK = 4096;          ///< Filas que se convierten de una vez.
+static const size_t ZLIB_MAX_RATIO = 1032;      ///< Máxima expansión de los datos al descomprimir con zlib.
+
+/**
+ * Constructor. Proyecta el fichero en memoria y analiza su estructura XML para
+ * saber si este lector es capaz de interpretarlo.
+ *
+ * @param [in]  file_name   Nombre del fichero de entrada.
+ * @param [in]  context     Contexto en el que se crean los conj. de datos.
+ **/
+VtkXmlReader::VtkXmlReader(const string& file_name, DatasetContext& context)
+    : AbstractReader(context), file(file_name) {
+    end = file.data() + file.size();
+    big_endian = false;
+    header_size = 4;
+    compressed = false;
+    is_valid = false;
+    appended_begin = nullptr;
+    appended_end = nullptr;
+    appended_base64 = false;
+    points_amount = 0;
+    elements = nullptr;
+    primitives = nullptr;
+
+    if (!file.isOpen())
+        return;
+
+    //Solo se analizan ficheros que comienzan como un documento XML.
+    const char* first = file.data();
+    while (first < end && isspace(static_cast<unsigned char>(*first)))
+        ++first;
+    if (end - first < 5 || (strncmp(first, "<?xml", 5) != 0 && strncmp(first, "<VTKFile", 5) != 0))
+        return;
+
+    is_valid = true;
+    parseStructure();
+}
+
+/**
+ * Indica si el fichero es un VTK XML que este lector sabe interpretar, esto es,
+ * de tipo UnstructuredGrid o PolyData y comprimido con zlib o sin comprimir.
+ *
+ * @return true si el fichero puede ser leido, false en caso contrario.
+ **/
+bool VtkXmlReader::isSupported() {
+    return file.isOpen() && is_valid &&
+           (dataset_type == "UnstructuredGrid" || dataset_type == "PolyData");
+}
+
+/**
+ * Lee el fichero y crea los conj. de datos "points", "elements", "primitives"
+ * y los de los arrays de atributos indicados. En PolyData los elementos se
+ * añaden en el mismo orden que usa VTK (vértices, lineas, polígonos y tiras de
+ * triángulos). El resto de arrays no se decodifican hasta que se piden.
+ *
+ * @param [in]  requested   Nombres de los arrays que se leen inmediatamente.
+ **/
+void VtkXmlReader::read(const vector<string>& requested) {
+    bool has_points = false;
+
+    for (const auto& array : arrays) {
+        if (array.section == "Points" && !has_points) {
+            readPoints(array);
+            has_points = true;
+        }
+    }
+
+    if (dataset_type == "UnstructuredGrid") {
+        readCells("Cells", -1);
+    }
+    else {
+        readCells("Verts", VTK_VERTEX);
+        readCells("Lines", VTK_LINE);
+        readCells("Polys", VTK_POLYGON);
+        readCells("Strips", VTK_TRIANGLE_STRIP);
+    }
+
+    for (const auto& array : arrays) {
+        if (isAttribute(array) && find(requested.begin(), requested.end(), array.name) != requested.end())
+            readArray(array);
+    }
+
+    //Aunque el fichero no tenga puntos o elementos se crean vacios igual que
+    //hacia VtkParser con el lector de VTK.
+    if (!has_points)
+        context.createDataset("double", "points", 0);
+    createCellDatasets();
+}
+
+/**
+ * Lee un array de atributos que no se pidió en read().
+ *
+ * @param [in]  name    Nombre del array.
+ * @return true si el array existe en el fichero y se ha creado.
+ **/
+bool VtkXmlReader::loadArray(const string& name) {
+    for (const auto& array : arrays) {
+        if (isAttribute(array) && array.name == name) {
+            readArray(array);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Recorre las etiquetas XML del fichero hasta AppendedData y guarda la
+ * descripción de cada DataArray de la primera pieza. El contenido de los
+ * elementos no se decodifica todavía.
+ **/
+void VtkXmlReader::parseStructure() {
+    static const char* sections[] = {"PointData", "CellData", "FieldData", "Points",
+                                     "Cells", "Verts", "Lines", "Strips", "Polys"};
+
+    const char* position = file.data();
+    string current_section;
+    int pieces = 0;
+
+    while (position < end) {
+        position = static_cast<const char*>(memchr(position, '<', end - position));
+        if (position == nullptr)
+            break;
+
+        if (end - position >= 2 && position[1] == '?') {
+            const char* close = search(position, end, "?>", "?>" + 2);
+            position = (close == end) ? end : close + 2;
+            continue;
+        }
+        if (end - position >= 4 && strncmp(position, "<!--", 4) == 0) {
+            const char* close = search(position, end, "-->", "-->" + 3);
+            position = (close == end) ? end : close + 3;
+            continue;
+        }
+
+        string name;
+        map<string, string> attributes;
+        bool self_closing;
+        const char* after = parseTag(position, name, attributes, self_closing);
+        if (after == nullptr) {
+            is_valid = false;
+            break;
+        }
+
+        if (name[0] == '/') {
+            if (name.compare(1, string::npos, current_section) == 0)
+                current_section.clear();
+        }
+        else if (name == "VTKFile") {
+            dataset_type = attributes["type"];
+            big_endian = (attributes["byte_order"] == "BigEndian");
+            header_size = (attributes["header_type"] == "UInt64") ? 8 : 4;
+
+            string compressor = attributes["compressor"];
+            compressed = !compressor.empty();
+            if (compressed && compressor != "vtkZLibDataCompressor") {
+                cout << "El compresor " << compressor << " no esta soportado." << endl;
+                is_valid = false;
+                break;
+            }
+        }
+        else if (name == "Piece") {
+            ++pieces;
+            if (pieces == 2)
+                cout << "El fichero tiene varias piezas, solo se leerá la primera." << endl;
+        }
+        else if (name == "DataArray") {
+            const char* content_end = after;
+            if (!self_closing) {
+                const char* close_tag = "</DataArray>";
+                content_end = search(after, end, close_tag, close_tag + strlen(close_tag));
+            }
+
+            if (pieces <= 1) {
+                XmlArray array;
+                array.section = current_section;
+                array.name = attributes["Name"];
+                array.kind = xmlTypeToKind(attributes["type"]);
+                array.format = attributes["format"];
+                array.components = atoi(attributes["NumberOfComponents"].c_str());
+                if (array.components <= 0)
+                    array.components = 1;
+                array.offset = strtoull(attributes["offset"].c_str(), nullptr, 10);
+                array.content_begin = after;
+                array.content_end = content_end;
+                arrays.push_back(array);
+            }
+
+            after = content_end;
+        }
+        else if (name == "AppendedData") {
+            appended_base64 = (attributes["encoding"] == "base64");
+
+            const char* underscore = static_cast<const char*>(memchr(after, '_', end - after));
+            appended_begin = (underscore == nullptr) ? end : underscore + 1;
+
+            //La etiqueta de cierre se busca solo al final del fichero para no
+            //recorrer todos los datos.
+            const char* close_tag = "</AppendedData>";
+            const char* window = max(appended_begin, end - min<size_t>(end - appended_begin, 1 << 16));
+            const char* close = find_end(window, end, close_tag, close_tag + strlen(close_tag));
+            appended_end = (close == end) ? end : close;
+            break;
+        }
+        else if (!self_closing) {
+            for (auto section : sections) {
+                if (name == section)
+                    current_section = name;
+            }
+        }
+
+        position = after;
+    }
+}
+
+/**
+ * Analiza una etiqueta XML (apertura, cierre o vacía) y sus atributos.
+ *
+ * @param [in]  position        Puntero al carácter '<' de la etiqueta.
+ * @param [out] name            Nombre de la etiqueta ("/Nombre" si es de cierre).
+ * @param [out] attributes      Atributos de la etiqueta.
+ * @param [out] self_closing    Indica si la etiqueta termina en "/>".
+ * @return Puntero al carácter siguiente a la etiqueta o nullptr si es incorrecta.
+ **/
+const char* VtkXmlReader::parseTag(const char* position, string& name, map<string, string>& attributes, bool& self_closing) {
+    const char* p = position + 1;
+    self_closing = false;
+
+    const char* name_begin = p;
+    while (p < end && !isspace(static_cast<unsigned char>(*p)) && *p != '>' && !(*p == '/' && p != name_begin))
+        ++p;
+    name.assign(name_begin, p);
+
+    while (p < end) {
+        while (p < end && isspace(static_cast<unsigned char>(*p)))
+            ++p;
+
+        if (p == end)
+            return nullptr;
+        if (*p == '>')
+            return p + 1;
+        if (*p == '/' && p + 1 < end && p[1] == '>') {
+            self_closing = true;
+            return p + 2;
+        }
+
+        const char* attribute_begin = p;
+        while (p < end && *p != '=' && !isspace(static_cast<unsigned char>(*p)))
+            ++p;
+        string attribute(attribute_begin, p);
+
+        while (p < end && (isspace(static_cast<unsigned char>(*p)) || *p == '='))
+            ++p;
+        if (p == end || (*p != '"' && *p != '\''))
+            return nullptr;
+
+        char quote = *p++;
+        const char* value_begin = p;
+        while (p < end && *p != quote)
+            ++p;
+        if (p == end)
+            return nullptr;
+
+        attributes[attribute].assign(value_begin, p);
+        ++p;
+    }
+
+    return nullptr;
+}
+
+/**
+ * Obtiene los valores de un DataArray sea cual sea su formato. Los arrays en
+ * ASCII se devuelven ya convertidos a double.
+ *
+ * @param [in]  array   Descripción del DataArray.
+ * @param [out] decoded Valores del array.
+ * @return false si los datos son incorrectos o el tipo no esta soportado.
+ **/
+bool VtkXmlReader::decodeArray(const XmlArray& array, DecodedArray& decoded) {
+    decoded.bytes.clear();
+    decoded.kind = array.kind;
+    decoded.swap_bytes = (big_endian != isBigEndianHost());
+
+    if (array.kind == KIND_UNKNOWN || array.kind == KIND_BIT) {
+        cout << "El tipo de dato del array " << array.name << " no esta soportado." << endl;
+        return false;
+    }
+
+    if (array.format == "ascii") {
+        decoded.kind = KIND_FLOAT64;
+        decoded.swap_bytes = false;
+
+        //El contenido termina en '<', que detiene a strtod.
+        const char* p = array.content_begin;
+        while (p < array.content_end) {
+            char* next;
+            double value = strtod(p, &next);
+            if (next == p)
+                break;
+            if (array.kind == KIND_FLOAT32)
+                value = static_cast<float>(value);
+
+            size_t size = decoded.bytes.size();
+            decoded.bytes.resize(size + sizeof(double));
+            memcpy(decoded.bytes.data() + size, &value, sizeof(double));
+            p = next;
+        }
+        return true;
+    }
+    else if (array.format == "binary") {
+        string content;
+        content.reserve(array.content_end - array.content_begin);
+        for (const char* p = array.content_begin; p < array.content_end; ++p) {
+            if (!isspace(static_cast<unsigned char>(*p)))
+                content += *p;
+        }
+        return decodeBinary(content.data(), content.data() + content.size(), true, decoded.bytes);
+    }
+    else if (array.format == "appended" && appended_begin != nullptr) {
+        if (array.offset > static_cast<size_t>(appended_end - appended_begin))
+            return false;
+        return decodeBinary(appended_begin + array.offset, appended_end, appended_base64, decoded.bytes);
+    }
+
+    return false;
+}
+
+/**
+ * Decodifica un bloque de datos binarios: una cabecera con su tamaño seguida
+ * de los datos, o si hay compresión una cabecera con el tamaño de cada bloque
+ * seguida de los bloques comprimidos. En base64 la cabecera de los datos
+ * comprimidos se codifica por separado.
+ *
+ * @param [in]  begin   Comienzo del bloque.
+ * @param [in]  limit   Final de la zona en la que se encuentra el bloque.
+ * @param [in]  base64  Indica si el bloque esta codificado en base64.
+ * @param [out] bytes   Datos decodificados y descomprimidos.
+ * @return false si los datos son incorrectos.
+ **/
+bool VtkXmlReader::decodeBinary(const char* begin, const char* limit, bool base64, vector<char>& bytes) {
+    size_t available = limit - begin;
+    vector<size_t> header;
+
+    if (!base64) {
+        if (!compressed) {
+            if (!readHeader(begin, available, 1, header) || header[0] > available - header_size)
+                return false;
+            bytes.assign(begin + header_size, begin + header_size + header[0]);
+            return true;
+        }
+
+        //Se comprueba el número de bloques antes de sumarle 3 para que no desborde
+        if (!readHeader(begin, available, 3, header) ||
+            header[0] > available / header_size - 3 ||
+            !readHeader(begin, available, 3 + header[0], header))
+            return false;
+
+        size_t header_bytes = header.size() * header_size;
+        return decompressBlocks(begin + header_bytes, available - header_bytes, header, bytes);
+    }
+
+    //Cada 4 carácteres base64 codifican 3 bytes.
+    size_t max_bytes = available / 4 * 3;
+    vector<char> prefix;
+    size_t prefix_chars = ((3 * header_size + 2) / 3) * 4;
+    if (prefix_chars > available)
+        return false;
+    prefix.resize(prefix_chars / 4 * 3);
+    decodeBase64(begin, prefix_chars, prefix.data());
+
+    if (!compressed) {
+        if (!readHeader(prefix.data(), prefix.size(), 1, header) ||
+            header[0] > max_bytes - header_size)
+            return false;
+
+        size_t total_chars = ((header_size + header[0] + 2) / 3) * 4;
+        if (total_chars > available)
+            return false;
+
+        vector<char> decoded(total_chars / 4 * 3);
+        parallelFor((total_chars + BASE64_CHUNK - 1) / BASE64_CHUNK, [&](size_t chunk) {
+            size_t first = chunk * BASE64_CHUNK;
+            size_t chars = min(BASE64_CHUNK, total_chars - first);
+            decodeBase64(begin + first, chars, decoded.data() + first / 4 * 3);
+        });
+
+        bytes.assign(decoded.begin() + header_size, decoded.begin() + header_size + header[0]);
+        return true;
+    }
+
+    if (!readHeader(prefix.data(), prefix.size(), 3, header) ||
+        header[0] > max_bytes / header_size - 3)
+        return false;
+
+    size_t header_chars = ((header_size * (3 + header[0]) + 2) / 3) * 4;
+    if (header_chars > available)
+        return false;
+    vector<char> header_bytes(header_chars / 4 * 3);
+    decodeBase64(begin, header_chars, header_bytes.data());
+    if (!readHeader(header_bytes.data(), header_bytes.size(), 3 + header[0], header))
+        return false;
+
+    size_t compressed_size = 0;
+    for (size_t i = 3; i < header.size(); ++i) {
+        if (header[i] > max_bytes - compressed_size)
+            return false;
+        compressed_size += header[i];
+    }
+
+    size_t data_chars = ((compressed_size + 2) / 3) * 4;
+    if (header_chars + data_chars > available)
+        return false;
+
+    vector<char> compressed_data(data_chars / 4 * 3);
+    const char* data_begin = begin + header_chars;
+    parallelFor((data_chars + BASE64_CHUNK - 1) / BASE64_CHUNK, [&](size_t chunk) {
+        size_t first = chunk * BASE64_CHUNK;
+        size_t chars = min(BASE64_CHUNK, data_chars - first);
+        decodeBase64(data_begin + first, chars, compressed_data.data() + first / 4 * 3);
+    });
+
+    return decompressBlocks(compressed_data.data(), compressed_data.size(), header, bytes);
+}
+
+/**
+ * Lee los enteros de una cabecera binaria, de 4 u 8 bytes según el atributo
+ * header_type del fichero.
+ *
+ * @param [in]  data        Comienzo de la cabecera.
+ * @param [in]  available   Bytes disponibles a partir de data.
+ * @param [in]  words       Número de enteros a leer.
+ * @param [out] header      Enteros leidos.
+ * @return false si no hay suficientes bytes.
+ **/
+bool VtkXmlReader::readHeader(const char* data, size_t available, size_t words, vector<size_t>& header) {
+    if (words > available / header_size)
+        return false;
+
+    header.resize(words);
+    convertValues((header_size == 8) ? KIND_UINT64 : KIND_UINT32, data, words,
+                  header.data(), big_endian != isBigEndianHost());
+
+    return true;
+}
+
+/**
+ * Descomprime en paralelo los bloques zlib de un array. Cada bloque se
+ * comprimió por separado, así que cada uno se escribe directamente en su
+ * posición final.
+ *
+ * @param [in]  data        Comienzo del primer bloque comprimido.
+ * @param [in]  available   Bytes disponibles a partir de data.
+ * @param [in]  header      Cabecera: número de bloques, tamaño de cada bloque,
+ *                          tamaño del último bloque (0 si esta completo) y el
+ *                          tamaño comprimido de cada bloque.
+ * @param [out] bytes       Datos descomprimidos.
+ * @return false si la cabecera o algún bloque son incorrectos, o si algún
+ *         bloque no ocupa lo indicado en la cabecera.
+ **/
+bool VtkXmlReader::decompressBlocks(const char* data, size_t available, const vector<size_t>& header, vector<char>& bytes) {
+    size_t blocks_amount = header[0];
+    size_t block_size = header[1];
+    size_t last_block_size = header[2];
+
+    if (blocks_amount == 0) {
+        bytes.clear();
+        return true;
+    }
+
+    //Los tamaños vienen del fichero, así que se comprueban antes de operar
+    //con ellos para que ningún cálculo desborde. zlib no expande los datos
+    //más de ZLIB_MAX_RATIO veces, lo que limita el tamaño total.
+    size_t max_size = (available > SIZE_MAX / ZLIB_MAX_RATIO) ? SIZE_MAX : available * ZLIB_MAX_RATIO;
+    if (header.size() < 3 + blocks_amount || last_block_size > block_size ||
+        block_size > max_size / blocks_amount) {
+        cout << "La cabecera de los datos comprimidos del fichero es incorrecta." << endl;
+        return false;
+    }
+
+    vector<size_t> block_begin(blocks_amount + 1, 0);
+    for (size_t i = 0; i < blocks_amount; ++i) {
+        if (header[3 + i] > available - block_begin[i])
+            return false;
+        block_begin[i+1] = block_begin[i] + header[3 + i];
+    }
+
+    size_t total_size = (last_block_size == 0) ? blocks_amount * block_size
+                                               : (blocks_amount - 1) * block_size + last_block_size;
+    bytes.resize(total_size);
+
+    atomic<bool> is_correct(true);
+    parallelFor(blocks_amount, [&](size_t i) {
+        uLongf expected = (i == blocks_amount - 1) ? total_size - i * block_size : block_size;
+        uLongf size = expected;
+        int result = uncompress(reinterpret_cast<Bytef*>(bytes.data() + i * block_size), &size,
+                                reinterpret_cast<const Bytef*>(data + block_begin[i]), header[3 + i]);
+
+        //Un bloque más corto de lo indicado dejaría bytes sin inicializar
+        if (result != Z_OK || size != expected)
+            is_correct = false;
+    });
+
+    if (!is_correct)
+        cout << "Error al descomprimir los datos del fichero." << endl;
+
+    return is_correct;
+}
+
+/**
+ * Lee las coordenadas de los puntos.
+ *
+ * @param [in]  array   DataArray de la sección Points.
+ **/
+void VtkXmlReader::readPoints(const XmlArray& array) {
+    DecodedArray decoded;
+    if (!decodeArray(array, decoded)) {
+        context.createDataset("double", "points", 0);
+        return;
+    }
+
+    size_t size = decoded.size() / 3;
+    DatasetAbstract* points = context.createDataset("double", "points", size);
+    points_amount = size;
+
+    size_t value_size = getValueSize(decoded.kind);
+    row.resize(ROWS_BLOCK * 3);
+    for (size_t first = 0; first < size; first += ROWS_BLOCK) {
+        size_t rows = min(ROWS_BLOCK, size - first);
+        convertValues(decoded.kind, decoded.bytes.data() + first * 3 * value_size, rows * 3,
+                      row.data(), decoded.swap_bytes);
+
+        for (size_t i = 0; i < rows; ++i) {
+            points->addData(row.data() + i * 3, 3);
+        }
+    }
+}
+
+/**
+ * Lee los elementos de una sección: los índices de sus puntos (connectivity),
+ * la posición en la que termina cada uno (offsets) y, en UnstructuredGrid, su
+ * tipo de primitiva (types).
+ *
+ * @param [in]  section Sección (Cells, Verts, Lines, Polys o Strips).
+ * @param [in]  kind    Tipo de sección de PolyData (VTK_VERTEX, VTK_LINE,
+ *                      VTK_POLYGON o VTK_TRIANGLE_STRIP) o -1 en
+ *                      UnstructuredGrid.
+ **/
+void VtkXmlReader::readCells(const string& section, int kind) {
+    const XmlArray* connectivity_array = findArray(section, "connectivity");
+    const XmlArray* offsets_array = findArray(section, "offsets");
+    const XmlArray* types_array = findArray(section, "types");
+
+    if (connectivity_array == nullptr || offsets_array == nullptr)
+        return;
+
+    DecodedArray connectivity, offsets, types;
+    if (!decodeArray(*connectivity_array, connectivity) || !decodeArray(*offsets_array, offsets))
+        return;
+    if (kind == -1 && (types_array == nullptr || !decodeArray(*types_array, types)))
+        return;
+
+    size_t cells = offsets.size();
+    if (elements == nullptr) {
+        elements = context.createDataset("unsigned int", "elements", cells);
+        primitives = context.createDataset("unsigned short", "primitives", cells);
+    }
+
+    size_t offset_size = getValueSize(offsets.kind);
+    size_t index_size = getValueSize(connectivity.kind);
+    size_t type_size = (kind == -1) ? getValueSize(types.kind) : 0;
+    size_t connectivity_size = connectivity.size();
+
+    double cell_begin = 0, cell_end;
+    for (size_t i = 0; i < cells; ++i) {
+        convertValues(offsets.kind, offsets.bytes.data() + i * offset_size, 1, &cell_end, offsets.swap_bytes);
+
+        size_t cell_points = static_cast<size_t>(cell_end - cell_begin);
+        if (cell_end < cell_begin || static_cast<size_t>(cell_end) > connectivity_size) {
+            cout << "Los elementos de la sección " << section << " son incorrectos." << endl;
+            return;
+        }
+
+        row.resize(cell_points);
+        convertValues(connectivity.kind, connectivity.bytes.data() + static_cast<size_t>(cell_begin) * index_size,
+                      cell_points, row.data(), connectivity.swap_bytes);
+
+        //Los índices se comprueban para que las salidas no accedan a puntos
+        //que no existen.
+        for (size_t j = 0; j < cell_points; ++j) {
+            if (!(row[j] >= 0 && row[j] < points_amount)) {
+                cout << "Los elementos de la sección " << section << " hacen referencia a puntos que no existen." << endl;
+                return;
+            }
+        }
+        elements->addData(row.data(), cell_points);
+
+        double primitive;
+        if (kind == -1)
+            convertValues(types.kind, types.bytes.data() + i * type_size, 1, &primitive, types.swap_bytes);
+        else
+            primitive = getPolyCellType(kind, cell_points);
+        primitives->addData(&primitive, 1);
+
+        cell_begin = cell_end;
+    }
+}
+
+/**
+ * Lee un array de atributos y lo almacena con su nombre y su tipo de dato
+ * nativo.
+ *
+ * @param [in]  array   DataArray de PointData, CellData o FieldData.
+ **/
+void VtkXmlReader::readArray(const XmlArray& array) {
+    DecodedArray decoded;
+    if (!decodeArray(array, decoded))
+        return;
+
+    int components = array.components;
+    size_t tuples = decoded.size() / components;
+    DatasetAbstract* array_dataset = context.createDataset(kindToNative(array.kind), array.name, tuples);
+
+    //Si los valores ya estan en el tipo y orden de bytes nativos se copian
+    //directamente sin pasar por double.
+    if (decoded.kind == array.kind && !decoded.swap_bytes &&
+        array_dataset->addRawData(decoded.bytes.data(), getValueSize(decoded.kind), tuples, components))
+        return;
+
+    size_t value_size = getValueSize(decoded.kind);
+    row.resize(ROWS_BLOCK * components);
+    for (size_t first = 0; first < tuples; first += ROWS_BLOCK) {
+        size_t rows = min(ROWS_BLOCK, tuples - first);
+        convertValues(decoded.kind, decoded.bytes.data() + first * components * value_size,
+                      rows * components, row.data(), decoded.swap_bytes);
+
+        for (size_t i = 0; i < rows; ++i) {
+            array_dataset->addData(row.data() + i * components, components);
+        }
+    }
+}
+
+/**
+ * Crea los conj. de datos "elements" y "primitives" vacios si el fichero no
+ * tiene elementos.
+ **/
+void VtkXmlReader::createCellDatasets() {
+    if (elements == nullptr) {
+        elements = context.createDataset("unsigned int", "elements", 0);
+        primitives = context.createDataset("unsigned short", "primitives", 0);
+    }
+}
+
+/**
+ * Busca un DataArray por sección y nombre.
+ *
+ * @param [in]  section Sección del array.
+ * @param [in]  name    Nombre del array.
+ * @return Puntero a la descripción del array o nullptr si no existe.
+ **/
+const VtkXmlReader::XmlArray* VtkXmlReader::findArray(const string& section, const string& name) {
+    for (const auto& array : arrays) {
+        if (array.section == section && array.name == name)
+            return &array;
+    }
+    return nullptr;
+}
+
+/**
+ * Indica si un DataArray es un array de atributos (PointData, CellData o
+ * FieldData).
+ *
+ * @param [in]  array   Descripción del array.
+ **/
+bool VtkXmlReader::isAttribute(const XmlArray& array) {
+    return array.section == "PointData" || array.section == "CellData" || array.section == "FieldData";
+}
+
+/**
+ * Traduce el nombre de un tipo de dato de VTK XML a ValueKind.
+ *
+ * @param [in]  type    Tipo de dato (Int32, Float64, etc).
+ * @return El tipo de dato o KIND_UNKNOWN si no esta soportado.
+ **/
+ValueKind VtkXmlReader::xmlTypeToKind(const string& type) {
+    if (type == "Int8" || type == "Char")
+        return KIND_INT8;
+    else if (type == "UInt8")
+        return KIND_UINT8;
+    else if (type == "Int16")
+        return KIND_INT16;
+    else if (type == "UInt16")
+        return KIND_UINT16;
+    else if (type == "Int32")
+        return KIND_INT32;
+    else if (type == "UInt32")
+        return KIND_UINT32;
+    else if (type == "Int64")
+        return KIND_INT64;
+    else if (type == "UInt64")
+        return KIND_UINT64;
+    else if (type == "Float32")
+        return KIND_FLOAT32;
+    else if (type == "Float64")
+        return KIND_FLOAT64;
+    else
+        return KIND_UNKNOWN;
+}
+
+/**
+ * Devuelve el tipo nativo de c++ que entiende DatasetContext::createDataset
+ * para cada tipo de dato.
+ *
+ * @param [in]  kind    Tipo de dato.
+ * @return String con el tipo nativo.
+ **/
+string VtkXmlReader::kindToNative(ValueKind kind) {
+    switch (kind) {
+        case KIND_INT8   : return "char";
+        case KIND_UINT8  : return "unsigned char";
+        case KIND_INT16  : return "short";
+        case KIND_UINT16 : return "unsigned short";
+        case KIND_INT32  : return "int";
+        case KIND_UINT32 : return "unsigned int";
+        case KIND_INT64  : return "int64_t";
+        case KIND_UINT64 : return "uint64_t";
+        case KIND_FLOAT32: return "float";
+        default          : return "double";
+    }
+}
+
+/**
+ * Decodifica una secuencia de carácteres base64. El carácter '=' de relleno se
+ * decodifica como 0, por lo que quien llama debe descartar los bytes
+ * sobrantes.
+ *
+ * @param [in]  data    Carácteres a decodificar, sin espacios.
+ * @param [in]  chars   Número de carácteres (múltiplo de 4).
+ * @param [out] output  Array de al menos chars / 4 * 3 bytes.
+ * @return Número de bytes escritos.
+ **/
+size_t VtkXmlReader::decodeBase64(const char* data, size_t chars, char* output) {
+    static signed char table[256];
+    static bool is_initialized = [] {
+        const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        fill(table, table + 256, 0);
+        for (int i = 0; i < 64; ++i) {
+            table[static_cast<unsigned char>(alphabet[i])] = i;
+        }
+        return true;
+    }();
+    (void) is_initialized;
+
+    size_t written = 0;
+    for (size_t i = 0; i + 3 < chars; i += 4) {
+        uint32_t group = (table[static_cast<unsigned char>(data[i])] << 18) |
+                         (table[static_cast<unsigned char>(data[i+1])] << 12) |
+                         (table[static_cast<unsigned char>(data[i+2])] << 6) |
+                         table[static_cast<unsigned char>(data[i+3])];
+
+        output[written++] = (group >> 16) & 0xFF;
+        output[written++] = (group >> 8) & 0xFF;
+        output[written++] = group & 0xFF;
+    }
+
+    return written;
+}
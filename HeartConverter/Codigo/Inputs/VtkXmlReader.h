@@ -0,0 +1,103 @@
+/**
+ * @file VtkXmlReader.h
+ *
+ * Lector propio de ficheros VTK XML de tipo UnstructuredGrid (.vtu) y
+ * PolyData (.vtp). Admite datos en ASCII, en base64 y "appended" (raw o
+ * base64), con o sin compresión zlib. Los bloques comprimidos son
+ * independientes y se descomprimen en paralelo.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#ifndef VTKXMLREADER_H
+#define VTKXMLREADER_H
+
+#include "AbstractReader.h"
+#include "BinaryValues.h"
+#include "MappedFile.h"
+#include <string>
+#include <vector>
+#include <map>
+
+class DatasetAbstract;
+
+class VtkXmlReader : public AbstractReader {
+public:
+    VtkXmlReader(const std::string&, DatasetContext&);
+
+    bool isSupported();
+    void read(const std::vector<std::string>&);
+    bool loadArray(const std::string&);
+
+private:
+
+    /**
+     * Descripción de un elemento DataArray del fichero.
+     **/
+    typedef struct XmlArray {
+        std::string section;        ///< Sección en la que se encuentra (Points, PointData, Cells...).
+        std::string name;           ///< Nombre del array.
+        ValueKind kind;             ///< Tipo de dato.
+        std::string format;         ///< ascii, binary o appended.
+        int components;             ///< Número de componentes de cada tupla.
+        size_t offset;              ///< Posición de los datos dentro de AppendedData.
+        const char* content_begin;  ///< Comienzo del contenido del elemento (ascii o binary).
+        const char* content_end;    ///< Final del contenido del elemento.
+    } XmlArray;
+
+    /**
+     * Valores de un array ya decodificados y descomprimidos.
+     **/
+    typedef struct DecodedArray {
+        std::vector<char> bytes;    ///< Valores en el orden de bytes del fichero.
+        ValueKind kind;             ///< Tipo de dato de los valores.
+        bool swap_bytes;            ///< Indica si hay que invertir el orden de los bytes.
+        size_t size() const { return bytes.size() / getValueSize(kind); }
+    } DecodedArray;
+
+    MappedFile file;                ///< Fichero de entrada proyectado en memoria.
+    const char* end;                ///< Final del fichero.
+
+    std::string dataset_type;       ///< Tipo de conj. de datos (UnstructuredGrid o PolyData).
+    bool big_endian;                ///< Orden de los bytes de los datos binarios.
+    size_t header_size;             ///< Tamaño de los enteros de las cabeceras (4 u 8 bytes).
+    bool compressed;                ///< Indica si los datos binarios estan comprimidos con zlib.
+    bool is_valid;                  ///< Indica si la estructura del fichero es correcta.
+
+    const char* appended_begin;     ///< Comienzo de los datos de AppendedData (tras el '_').
+    const char* appended_end;       ///< Final de los datos de AppendedData.
+    bool appended_base64;           ///< Indica si AppendedData esta codificado en base64.
+
+    std::vector<XmlArray> arrays;   ///< DataArray de la primera pieza, en orden.
+    std::vector<double> row;        ///< Fila auxiliar reutilizada para no reservar memoria por elemento.
+
+    size_t points_amount;           ///< Número de puntos leidos.
+    DatasetAbstract* elements;      ///< Índices de los puntos de cada elemento.
+    DatasetAbstract* primitives;    ///< Tipo de primitiva de cada elemento.
+
+    void parseStructure();
+    const char* parseTag(const char*, std::string&, std::map<std::string, std::string>&, bool&);
+
+    bool decodeArray(const XmlArray&, DecodedArray&);
+    bool decodeBinary(const char*, const char*, bool, std::vector<char>&);
+    bool readHeader(const char*, size_t, size_t, std::vector<size_t>&);
+    bool decompressBlocks(const char*, size_t, const std::vector<size_t>&, std::vector<char>&);
+
+    void readPoints(const XmlArray&);
+    void readCells(const std::string&, int);
+    void readArray(const XmlArray&);
+    void createCellDatasets();
+
+    const XmlArray* findArray(const std::string&, const std::string&);
+
+    static bool isAttribute(const XmlArray&);
+    static ValueKind xmlTypeToKind(const std::string&);
+    static std::string kindToNative(ValueKind);
+    static size_t decodeBase64(const char*, size_t, char*);
+};
+
+#endif /* VTKXMLREADER_H */
+
@@ -0,0 +1,92 @@
+/**
+ * @file BufferedSink.cpp
+ *
+ * Destino de un fichero de salida que acumula los carácteres en un buffer
+ * grande y lo escribe con una sola llamada a write cada vez que se llena.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#include "BufferedSink.h"
+#include <string>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+/**
+ * Constructor. Crea el fichero, o lo vacía si ya existía. Si no se puede
+ * crear isOpen() devolverá false.
+ *
+ * @param [in]  file_name   Nombre del fichero.
+ **/
+BufferedSink::BufferedSink(const string& file_name) : buffer(BUFFER_SIZE) {
+    descriptor = open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    is_open = (descriptor >= 0);
+    setp(buffer.data(), buffer.data() + buffer.size());
+}
+
+/**
+ * Escribe el área de escritura en el fichero y la deja vacía.
+ *
+ * @return false si no se han podido escribir los datos.
+ **/
+bool BufferedSink::flushArea() {
+    bool written = writeAll(descriptor, pbase(), pptr() - pbase());
+    setp(buffer.data(), buffer.data() + buffer.size());
+    return written;
+}
+
+/**
+ * Escribe lo que quede en el buffer y cierra el fichero.
+ *
+ * @return true si todos los datos se han escrito.
+ **/
+bool BufferedSink::close() {
+    if (descriptor < 0)
+        return false;
+
+    if (is_open && !flushArea())
+        is_open = false;
+
+    if (::close(descriptor) != 0)
+        is_open = false;
+
+    descriptor = -1;
+    return is_open;
+}
+
+/**
+ * Destructor. Cierra el fichero si no se había cerrado.
+ **/
+BufferedSink::~BufferedSink() {
+    close();
+}
+
+/**
+ * Escribe un bloque completo en un fichero, repitiendo la llamada a write
+ * cuando escribe solo una parte o la interrumpe una señal.
+ *
+ * @param [in]  descriptor  Descriptor del fichero.
+ * @param [in]  data        Carácteres a escribir.
+ * @param [in]  size        Número de carácteres.
+ * @return false si ha fallado la escritura.
+ **/
+bool writeAll(int descriptor, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(descriptor, data, size);
+
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            return false;
+
+        data += written;
+        size -= written;
+    }
+
+    return true;
+}
@@ -0,0 +1,42 @@
+/**
+ * @file BufferedSink.h
+ *
+ * Destino de un fichero de salida que acumula los carácteres en un buffer
+ * grande y lo escribe con una sola llamada a write cada vez que se llena.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#ifndef BUFFEREDSINK_H
+#define BUFFEREDSINK_H
+
+#include <string>
+#include <vector>
+#include "OutputSink.h"
+
+class BufferedSink : public OutputSink {
+public:
+
+    static const size_t BUFFER_SIZE = 1 << 22;  ///< Tamaño del buffer, 4 MiB.
+
+    BufferedSink(const std::string&);
+
+    bool close() override;
+
+    ~BufferedSink();
+
+protected:
+
+    bool flushArea() override;
+
+private:
+    int descriptor;             ///< Descriptor del fichero, -1 si está cerrado.
+    std::vector<char> buffer;   ///< Carácteres pendientes de escribir.
+};
+
+bool writeAll(int, const char*, size_t);
+
+#endif /* BUFFEREDSINK_H */
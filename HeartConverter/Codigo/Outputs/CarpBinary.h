@@ -0,0 +1,47 @@
+/**
+ * @file CarpBinary.h
+ * 
+ * Constantes y funciones comunes de los ficheros binarios de CARP (.bpts y
+ * .belem). Estos ficheros comienzan con una cabecera de texto de tamaño fijo
+ * con el número de filas, el orden de bytes y un valor de control, seguida de
+ * los valores en binario con el orden de bytes de la máquina.
+ * 
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ * 
+ **/
+
+#ifndef CARPBINARY_H
+#define CARPBINARY_H
+
+#include <iostream>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+static const size_t CARP_BINARY_HEADER_SIZE = 1024;    ///< Tamaño de la cabecera.
+static const unsigned long CARP_BINARY_CHECKSUM = 666; ///< Valor de control de la cabecera.
+static const int CARP_LITTLE_ENDIAN = 0;                ///< Orden de bytes "little endian".
+static const int CARP_BIG_ENDIAN = 1;                   ///< Orden de bytes "big endian".
+
+/**
+ * Escribe la cabecera de un fichero binario de CARP: el número de filas, el
+ * orden de bytes de la máquina y el valor de control, rellenando con ceros
+ * hasta CARP_BINARY_HEADER_SIZE.
+ * 
+ * @param [in,out]  where   "Output stream" en el que se escribe la cabecera.
+ * @param [in]      rows    Número de puntos o elementos del fichero.
+ **/
+inline void writeCarpBinaryHeader(std::ostream& where, size_t rows) {
+    char header[CARP_BINARY_HEADER_SIZE];
+    memset(header, 0, sizeof(header));
+    
+    const uint16_t byte_order = 1;
+    int endianness = (*(const uint8_t*) &byte_order == 1) ? CARP_LITTLE_ENDIAN : CARP_BIG_ENDIAN;
+    
+    snprintf(header, sizeof(header), "%lu %d %lu", (unsigned long) rows, endianness, CARP_BINARY_CHECKSUM);
+    where.write(header, sizeof(header));
+}
+
+#endif /* CARPBINARY_H */
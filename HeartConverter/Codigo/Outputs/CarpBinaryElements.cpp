@@ -0,0 +1,123 @@
+/**
+ * @file CarpBinaryElements.cpp
+ * 
+ * Clase que representa un fichero de elementos binario (.belem) en CARP.
+ * 
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ * 
+ **/
+
+#include "CarpBinaryElements.h"
+#include "../Datasets/DatasetContext.h"
+#include "./../Datasets/DatasetAbstract.h"
+#include "./../Datasets/Dataset.h"
+#include "CarpBinary.h"
+#include "CarpElementTypes.h"
+#include "vtkCellType.h"
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+using namespace std;
+
+static const size_t BINARY_ELEMENTS_CHUNK = 1 << 14;    ///< Elementos que se convierten y escriben de una vez.
+
+/**
+ * Constructor. Llama al constructor de la clase de la que hereda para
+ * inicializar los valores del nombre y extensión del fichero (.belem). También
+ * inicializa los punteros a la información necesaria y traduce el tipo de
+ * primitiva de VTK de cada elemento al tipo de elemento de CARP.
+ * 
+ * @param [in]  name    Nombre del fichero.
+ * @param [in]  context Contexto del que se obtienen los conj. de datos, debe
+ *                      de vivir más que el fichero.
+ **/
+CarpBinaryElements::CarpBinaryElements(const string& name, DatasetContext& context) : AbstractFile(name, ".belem") {
+    elements = context.getDataset("elements");
+    primitives = context.getDataset("primitives");
+    regions = context.getDataset("regions");
+    supported_amount = 0;
+    
+    if (primitives != nullptr){
+        calcTypes();
+    }
+}
+
+/**
+ * Devuelve los nombres de los arrays de atributos que necesita el fichero,
+ * para que se lean junto con los puntos y elementos. Necesita la
+ * región de cada elemento.
+ * 
+ * @return Vector con los nombres de los arrays.
+ **/
+vector<string> CarpBinaryElements::getRequiredArrays() {
+    return {"regions"};
+}
+
+/**
+ * Función que escribe la cabecera y, por cada elemento, su tipo, los índices
+ * de sus puntos y su región como enteros de 32 bits. Los elementos que CARP no
+ * soporta no se escriben. Si no hay regiones se escribe la región 0. Los
+ * índices se leen en su tipo nativo y se convierten y escriben por bloques.
+ * 
+ * @param [in,out]  where   "Output stream" en el que se escribirá la info.
+ **/
+void CarpBinaryElements::print(std::ostream& where) const{
+    
+    writeCarpBinaryHeader(where, supported_amount);
+    
+    visitDataset(elements, [&](auto& typed_elements) {
+        size_t elements_amount = min(typed_elements.size(), element_types.size());
+        vector<int32_t> chunk;
+        
+        for (size_t first = 0; first < elements_amount; first += BINARY_ELEMENTS_CHUNK) {
+            size_t end = min(elements_amount, first + BINARY_ELEMENTS_CHUNK);
+            
+            chunk.clear();
+            for (size_t i = first; i < end; ++i) {
+                if (element_types[i] < 0)
+                    continue;
+                
+                chunk.push_back(element_types[i]);
+                for (auto index : typed_elements.getRow(i)) {
+                    chunk.push_back((int32_t) index);
+                }
+                chunk.push_back(regions != nullptr ? (int32_t) regions->getValue(i, 0) : 0);
+            }
+            where.write((const char*) chunk.data(), chunk.size() * sizeof(int32_t));
+        }
+    });
+    
+}
+
+/**
+ * Itera sobre cada una de las primitivas de cada elemento obteniendo y 
+ * almacenando su tipo equivalente en CARP. Los polígonos se escriben como
+ * triángulos, así que solo se admiten los que tienen 3 puntos. Los elementos
+ * con primitivas que CARP no soporta se cuentan y se muestran al final.
+ **/
+void CarpBinaryElements::calcTypes() {
+    size_t unsupported = 0;
+    
+    element_types.reserve(primitives->size());
+    for (unsigned int i = 0; i < primitives->size(); ++i){
+        int primitive = primitives->getValue(i, 0);
+        int32_t type = getCarpElementType(primitive);
+        
+        if (primitive == VTKCellType::VTK_POLYGON &&
+            (elements == nullptr || i >= elements->size() || elements->getDataDimension(i) != 3))
+            type = CARP_UNSUPPORTED;
+        
+        element_types.push_back(type);
+        
+        if (type < 0)
+            ++unsupported;
+    }
+    supported_amount = element_types.size() - unsupported;
+    
+    if (unsupported > 0){
+        cout << "Primitive not supported in " << unsupported << " elements." << endl;
+    }
+}
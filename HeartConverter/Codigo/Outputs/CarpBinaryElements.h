@@ -0,0 +1,41 @@
+/**
+ * @file CarpBinaryElements.h
+ * 
+ * Clase que representa un fichero de elementos binario (.belem) en CARP.
+ * 
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ * 
+ **/
+
+#ifndef CARPBINARYELEMENTS_H
+#define CARPBINARYELEMENTS_H
+
+#include "AbstractFile.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+class DatasetAbstract;
+class DatasetContext;
+
+class CarpBinaryElements : public AbstractFile{
+public:
+    CarpBinaryElements(const std::string&, DatasetContext&);
+    
+    void print(std::ostream&) const;
+    
+    static std::vector<std::string> getRequiredArrays();
+private:
+    DatasetAbstract* elements;              ///< Puntero a los índices de los puntos que componen cada elemento.
+    DatasetAbstract* primitives;            ///< Puntero al tipo de primitiva de cada elemento.
+    DatasetAbstract* regions;               ///< Puntero a la región asignada para cada elemento.
+    std::vector<int32_t> element_types;     ///< Tipo de CARP de cada elemento, -1 si no lo soporta.
+    size_t supported_amount;                ///< Número de elementos que soporta CARP.
+    
+    void calcTypes();
+
+};
+
+#endif /* CARPBINARYELEMENTS_H */
@@ -0,0 +1,84 @@
+/**
+ * @file CarpBinaryPoints.cpp
+ * 
+ * Clase que representa un fichero de puntos binario (.bpts) en CARP.
+ * 
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ * 
+ **/
+
+#include "CarpBinaryPoints.h"
+#include "../Datasets/DatasetContext.h"
+#include "./../Datasets/DatasetAbstract.h"
+#include "./../Datasets/Dataset.h"
+#include "CarpBinary.h"
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+using namespace std;
+
+static const size_t BINARY_POINTS_CHUNK = 1 << 14;  ///< Puntos que se convierten y escriben de una vez.
+
+/**
+ * Constructor. Inicializa el nombre del fichero. La extensión se asigna de
+ * forma automática (.bpts).
+ * 
+ * @param [in]  name    Nombre del fichero
+ * @param [in]  context Contexto del que se obtienen los conj. de datos, debe
+ *                      de vivir más que el fichero.
+ **/
+CarpBinaryPoints::CarpBinaryPoints(const string& name, DatasetContext& context) : AbstractFile(name, string(".bpts")) {
+    points = context.getDataset("points");
+}
+
+/**
+ * Devuelve los nombres de los arrays de atributos que necesita el fichero,
+ * para que se lean junto con los puntos y elementos. Solo necesita
+ * las coordenadas de los puntos.
+ * 
+ * @return Vector con los nombres de los arrays.
+ **/
+vector<string> CarpBinaryPoints::getRequiredArrays() {
+    return {};
+}
+
+/**
+ * Función que escribe la cabecera y las coordenadas de cada punto como tres
+ * float. Las coordenadas se leen en su tipo nativo y se convierten y escriben
+ * por bloques. En el caso de no exisir ningún punto no crea el fichero.
+ * 
+ * @param [in,out]  where   "Output stream" en el que se escribirá la info.
+ **/
+void CarpBinaryPoints::print(std::ostream& where) const {
+
+    size_t points_size = points->size();
+    
+    if (points_size == 0){
+        cout << "Error: No existe ningun punto" << endl;
+        cout << "No se puede crear un fichero de puntos" << endl;
+        return;
+    }
+    
+    writeCarpBinaryHeader(where, points_size);
+    
+    visitDataset(points, [&where, points_size](auto& typed_points) {
+        vector<float> chunk;
+        chunk.reserve(3 * BINARY_POINTS_CHUNK);
+        
+        for (size_t first = 0; first < points_size; first += BINARY_POINTS_CHUNK) {
+            size_t end = min(points_size, first + BINARY_POINTS_CHUNK);
+            
+            chunk.clear();
+            for (size_t i = first; i < end; ++i) {
+                auto coords = typed_points.getRow(i);
+                for (size_t j = 0; j < 3; ++j) {
+                    chunk.push_back(j < coords.size() ? (float) coords[j] : 0.0f);
+                }
+            }
+            where.write((const char*) chunk.data(), chunk.size() * sizeof(float));
+        }
+    });
+}
@@ -0,0 +1,36 @@
+/**
+ * @file CarpBinaryPoints.h
+ * 
+ * Clase que representa un fichero de puntos binario (.bpts) en CARP.
+ * 
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ * 
+ **/
+
+#ifndef CARPBINARYPOINTS_H
+#define CARPBINARYPOINTS_H
+
+#include "AbstractFile.h"
+#include <string>
+#include <vector>
+#include <iostream>
+
+class DatasetAbstract;
+class DatasetContext;
+
+class CarpBinaryPoints : public AbstractFile{
+public:
+
+    CarpBinaryPoints(const std::string&, DatasetContext&);
+    
+    void print(std::ostream&) const;
+    
+    static std::vector<std::string> getRequiredArrays();
+    
+private:
+    DatasetAbstract* points;    ///< Puntero a las coordenadas de los puntos.
+};
+
+#endif /* CARPBINARYPOINTS_H */
@@ -0,0 +1,79 @@
+/**
+ * @file CarpElementTypes.h
+ *
+ * Tipos de elemento de CARP y su traducción desde los tipos de primitiva de
+ * VTK, común a los ficheros de elementos de texto (.elem) y binarios
+ * (.belem). La traducción esta basada y debe de mantenerse actualizada de
+ * acuerdo al fichero vtkCellType.h.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#ifndef CARPELEMENTTYPES_H
+#define CARPELEMENTTYPES_H
+
+#include "vtkCellType.h"
+#include <cstdint>
+
+/**
+ * Tipos de elemento de CARP, con los mismos valores que en su fichero binario.
+ **/
+enum CarpElementType : int32_t {
+    CARP_UNSUPPORTED = -1,
+    CARP_TETRA = 0,
+    CARP_HEXA,
+    CARP_OCTA,
+    CARP_PYRAMID,
+    CARP_PRISM,
+    CARP_QUAD,
+    CARP_TRI,
+    CARP_LINE
+};
+
+/**
+ * Devuelve el tipo de elemento de CARP equivalente a un tipo de primitiva de
+ * VTK. Los polígonos se escriben como triángulos.
+ *
+ * @param [in]  type    Entero que representa el tipo de primitiva en VTK.
+ * @return El tipo de elemento de CARP o CARP_UNSUPPORTED si CARP no soporta
+ *         el tipo de primitiva.
+ **/
+inline CarpElementType getCarpElementType(int type) {
+    switch (type) {
+        case VTKCellType::VTK_LINE      : return CARP_LINE;
+        case VTKCellType::VTK_TRIANGLE  : return CARP_TRI;
+        case VTKCellType::VTK_POLYGON   : return CARP_TRI;
+        case VTKCellType::VTK_QUAD      : return CARP_QUAD;
+        case VTKCellType::VTK_TETRA     : return CARP_TETRA;
+        case VTKCellType::VTK_PYRAMID   : return CARP_PYRAMID;
+        case VTKCellType::VTK_WEDGE     : return CARP_PRISM;
+        case VTKCellType::VTK_HEXAHEDRON: return CARP_HEXA;
+        default                         : return CARP_UNSUPPORTED;
+    }
+}
+
+/**
+ * Devuelve el "tag" con el que se escribe un tipo de elemento de CARP en los
+ * ficheros de texto.
+ *
+ * @param [in]  type    Tipo de elemento de CARP.
+ * @return El "tag" o un string vacio si el tipo no está soportado.
+ **/
+inline const char* getCarpElementTag(CarpElementType type) {
+    switch (type) {
+        case CARP_TETRA  : return "Tt";
+        case CARP_HEXA   : return "Hx";
+        case CARP_OCTA   : return "Oc";
+        case CARP_PYRAMID: return "Py";
+        case CARP_PRISM  : return "Pr";
+        case CARP_QUAD   : return "Qd";
+        case CARP_TRI    : return "Tr";
+        case CARP_LINE   : return "Ln";
+        default          : return "";
+    }
+}
+
+#endif /* CARPELEMENTTYPES_H */
@@ -10,8 +10,11 @@
  **/
 
 #include "CarpElements.h"
+#include "../Datasets/DatasetContext.h"
 #include "./../Datasets/DatasetAbstract.h"
-#include "vtkCellType.h"
+#include "./../Datasets/Dataset.h"
+#include "OutputBuffer.h"
+#include "CarpElementTypes.h"
 #include <string>
 #include <vector>
 #include <iostream>
@@ -25,18 +28,31 @@ using namespace std;
  * equivalente en CARP.
  * 
  * @param [in]  name    Nombre del fichero.
+ * @param [in]  context Contexto del que se obtienen los conj. de datos, debe
+ *                      de vivir más que el fichero.
  **/
-CarpElements::CarpElements(const string& name) : AbstractFile(name, ".elem") {
-    points = DatasetAbstract::getDataset("points");
-    elements = DatasetAbstract::getDataset("elements");
-    primitives = DatasetAbstract::getDataset("primitives");
-    regions = DatasetAbstract::getDataset("regions");
+CarpElements::CarpElements(const string& name, DatasetContext& context) : AbstractFile(name, ".elem") {
+    points = context.getDataset("points");
+    elements = context.getDataset("elements");
+    primitives = context.getDataset("primitives");
+    regions = context.getDataset("regions");
     
     if (primitives != nullptr){
         calcPrimitives();
     }
 }
 
+/**
+ * Devuelve los nombres de los arrays de atributos que necesita el fichero,
+ * para que se lean junto con los puntos y elementos. Las regiones se
+ * escriben junto a cada elemento.
+ * 
+ * @return Vector con los nombres de los arrays.
+ **/
+vector<string> CarpElements::getRequiredArrays() {
+    return {"regions"};
+}
+
 /**
  * Función que compureba que el fichero de configuración exista o lo crea en 
  * caso contrario. Tras esto asigna los valores del fichero a los parámetros de
@@ -44,27 +60,23 @@ CarpElements::CarpElements(const string& name) : AbstractFile(name, ".elem") {
  **/
 void CarpElements::print(std::ostream& where) const{
     
-    vector<double> element;
-    vector<double> region;
-    
     where << elements->size() << "\n";
     
-    for (unsigned int i = 0; i < elements->size(); ++i) {
-        elements->getData(i, element);
-        
-        where << primitives_tag[i];
-        
-        for (auto index : element){
-            where << " " << index;
-        }
-        
-        if (regions != nullptr){
-            regions->getData(i, region);
-            where << " " <<region[0];
-        }
-        
-        where << endl;
-    }
+    visitDataset(elements, [&](auto& typed_elements) {
+        parallelWriteRows(where, typed_elements.size(), [&](OutputBuffer& buffer, size_t i) {
+            buffer << primitives_tag[i];
+            
+            for (auto index : typed_elements.getRow(i)){
+                buffer << " " << index;
+            }
+            
+            if (regions != nullptr){
+                buffer << " " << regions->getValue(i, 0);
+            }
+            
+            buffer << "\n";
+        });
+    });
     
 }
 
@@ -74,49 +86,33 @@ void CarpElements::print(std::ostream& where) const{
  **/
 void CarpElements::calcPrimitives() {
     string tag;
-    vector<double> primitive;
     
+    primitives_tag.reserve(primitives->size());
     for (unsigned int i = 0; i < primitives->size(); ++i){
-        primitives->getData(i, primitive);
-        tag = getPrimitiveTag(primitive[0]);
+        tag = getPrimitiveTag(primitives->getValue(i, 0));
         primitives_tag.push_back(tag);
     }
 }
 
 /**
  * Devuelve el string equivalente en CARP para los distintos tipos de primitiva
- * de VTK. Si el tipo de primitiva no esta implementado en CARP se lanza un
- * mensaje de error y se devuelve un string vacio. La traducción entero-string 
- * esta basado y debe de mantenerse actualizado de acuerdo al fichero
- * vtkCellType.h.
+ * de VTK, con la traducción de getCarpElementType. Si el tipo de primitiva no
+ * esta implementado en CARP se lanza un mensaje de error y se devuelve un
+ * string vacio.
  * 
  * @param [in]  type    Entero que representa el tipo de primitiva en VTK.
  * @return String con el tag adecuado o un string vacio si CARP no soporta
  *         el tipo de primitiva.
  **/
 string CarpElements::getPrimitiveTag(const int type) {
-    //vtkCellType cell_type;
+    CarpElementType carp_type = getCarpElementType(type);
     
-    if (type == VTKCellType::VTK_LINE)
-        return "Ln";
-    else if (type == VTKCellType::VTK_TRIANGLE)
-        return "Tr";
-    else if (type == VTKCellType::VTK_POLYGON)
-        return "Tr";
-    else if (type == VTKCellType::VTK_QUAD)
-        return "Qd";
-    else if (type == VTKCellType::VTK_TETRA)
-        return "Tt";
-    else if (type == VTKCellType::VTK_PYRAMID)
-        return "Py";
-    else if (type == VTKCellType::VTK_WEDGE)
-        return "Pr";
-    else if (type == VTKCellType::VTK_HEXAHEDRON)
-        return "Hx";
-    else{
+    if (carp_type == CARP_UNSUPPORTED){
         cout << "Primitive not supported." << endl;
         return "";
     }
+    
+    return getCarpElementTag(carp_type);
 }
 
 
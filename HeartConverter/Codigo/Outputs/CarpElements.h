@@ -17,12 +17,15 @@
 #include <vector>
 
 class DatasetAbstract;
+class DatasetContext;
 
 class CarpElements : public AbstractFile{
 public:
-    CarpElements(const std::string&);
+    CarpElements(const std::string&, DatasetContext&);
     
     void print(std::ostream&) const;
+    
+    static std::vector<std::string> getRequiredArrays();
 private:
     DatasetAbstract* points;                ///< Puntero a las coordenadas de los puntos.
     DatasetAbstract* elements;              ///< Puntero a los índices de los puntos que componen cada elemento.
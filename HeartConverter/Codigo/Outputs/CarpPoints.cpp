@@ -10,9 +10,13 @@
  **/
 
 #include "CarpPoints.h"
+#include "../Datasets/DatasetContext.h"
 #include <string>
+#include <vector>
 #include <iostream>
 #include "./../Datasets/DatasetAbstract.h"
+#include "./../Datasets/Dataset.h"
+#include "OutputBuffer.h"
 using namespace std;
 
 /**
@@ -20,15 +24,29 @@ using namespace std;
  * forma automática (.pts).
  * 
  * @param [in]  name    Nombre del fichero
+ * @param [in]  context Contexto del que se obtienen los conj. de datos, debe
+ *                      de vivir más que el fichero.
  **/
-CarpPoints::CarpPoints(const string& name) : AbstractFile(name, string(".pts")) {
-    points = DatasetAbstract::getDataset("points");
+CarpPoints::CarpPoints(const string& name, DatasetContext& context) : AbstractFile(name, string(".pts")) {
+    points = context.getDataset("points");
+}
+
+/**
+ * Devuelve los nombres de los arrays de atributos que necesita el fichero,
+ * para que se lean junto con los puntos y elementos. Solo necesita
+ * las coordenadas de los puntos.
+ * 
+ * @return Vector con los nombres de los arrays.
+ **/
+vector<string> CarpPoints::getRequiredArrays() {
+    return {};
 }
 
 /**
  * Función que escribe los datos necesarios y con la sintaxis adecuada a
  * cualquier tipo de "output stream". En el caso de no exisir ningún punto no 
- * crea el fichero.
+ * crea el fichero. Las coordenadas se leen directamente en su tipo nativo y
+ * los puntos se escriben en paralelo con parallelWriteRows.
  * 
  * @param [in,out]  where   "Output stream" en el que se escribirá la info.
  **/
@@ -44,17 +62,19 @@ void CarpPoints::print(std::ostream& where) const {
     
     where << points_size << "\n";
     
-    vector<double> coords;
-    for (size_t i = 0; i < points_size; ++i) {
-        size_t points_dimension = points->getDataDimension(i);
-        points->getData(i, coords);
-        
-        where << coords[0];
-        for (size_t j = 1; j < points_dimension; ++j){
-            where << " " << coords[j];
-        }
-        where << "\n";
-    }
+    visitDataset(points, [&where, points_size](auto& typed_points) {
+        parallelWriteRows(where, points_size, [&typed_points](OutputBuffer& buffer, size_t i) {
+            auto coords = typed_points.getRow(i);
+            if (coords.size() == 0)
+                return;
+            
+            buffer << coords[0];
+            for (size_t j = 1; j < coords.size(); ++j){
+                buffer << " " << coords[j];
+            }
+            buffer << "\n";
+        });
+    });
     
     where << "\0";
 }
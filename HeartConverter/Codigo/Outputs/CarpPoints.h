@@ -14,17 +14,21 @@
 
 #include "AbstractFile.h"
 #include <string>
+#include <vector>
 #include <iostream>
 
 class DatasetAbstract;
+class DatasetContext;
 
 class CarpPoints : public AbstractFile{
 public:
 
-    CarpPoints(const std::string&);
+    CarpPoints(const std::string&, DatasetContext&);
     
     void print(std::ostream&) const;
     
+    static std::vector<std::string> getRequiredArrays();
+    
 private:
     DatasetAbstract* points; ///< Puntero a las coordenadas de todos los puntos.
 
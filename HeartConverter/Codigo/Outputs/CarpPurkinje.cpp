@@ -10,6 +10,9 @@
  **/
 
 #include "CarpPurkinje.h"
+#include "../Datasets/DatasetContext.h"
+#include "../Datasets/Dataset.h"
+#include "OutputBuffer.h"
 #include <vector>
 #include <array>
 #include <iostream>
@@ -19,8 +22,15 @@
 #include <exception>
 #include <algorithm>
 #include <functional>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <cmath>
+#include "../Parallel.h"
 using namespace std;
 
+static const unsigned int NO_NODE = UINT_MAX;   ///< Hueco vacio en la tabla de nodos.
+
 /**
  * Constructor. Llama al constructor de la clase de la que hereda para
  * inicializar los valores del nombre y extensión del fichero (.pkje). También
@@ -28,39 +38,57 @@ using namespace std;
  * guardan las relaciones de padres e hijos entre fibras de Purkinje. Finalmente
  * llama a las funciones requeridas que calculan el resto de datos necesarios
  * para producir el fichero, como el fichero de configuración o las relaciones
- * entre fibras.
+ * entre fibras. Las relaciones entre cables se reservan en la arena del
+ * contexto.
  * 
- * @param [in]  name    Nombre del fichero.
+ * @param [in]  name            Nombre del fichero.
+ * @param [in]  context         Contexto del que se obtienen los conj. de
+ *                              datos, debe de vivir más que el fichero.
+ * @param [in]  merge_chains    Indica si los cables sin bifurcaciones entre
+ *                              ellos se escriben como un único cable.
  **/
-CarpPurkinje::CarpPurkinje(const std::string& name) : AbstractFile(name, ".pkje") {
+CarpPurkinje::CarpPurkinje(const std::string& name, DatasetContext& context, bool merge_chains)
+    : AbstractFile(name, ".pkje"), cable_origin(context.getResource()),
+      cable_begin(context.getResource()), cable_end(context.getResource()),
+      sons(context.getResource()), parents(context.getResource()),
+      relations(context.getResource()), cable_chain(context.getResource()),
+      chain_offset(context.getResource()), chain_cables(context.getResource()),
+      merge_chains(merge_chains) {
     
-    points = DatasetAbstract::getDataset("points");
-    elements = DatasetAbstract::getDataset("elements");
+    points = context.getDataset("points");
+    elements = context.getDataset("elements");
     
     setAttributesValues();
     calcRelations();
     removeExtraRelations();
+    buildChains();
+    buildCableGraph();
     
     printSeveralParents();
 
 }
 
+/**
+ * Devuelve los nombres de los arrays de atributos que necesita el fichero,
+ * para que se lean junto con los puntos y elementos. Las fibras
+ * solo necesitan los puntos y los elementos.
+ * 
+ * @return Vector con los nombres de los arrays.
+ **/
+vector<string> CarpPurkinje::getRequiredArrays() {
+    return {};
+}
+
+/**
+ * Muestra los nodos en los que siguen terminando más cables de los que admite
+ * CARP como padres de una misma fibra, porque no se han podido separar.
+ **/
 void CarpPurkinje::printSeveralParents() {
     
-    for (auto it = searchParents.begin(); it != searchParents.end(); ) {
-        unsigned int number_relations = 0;
-        
-        auto range = searchSons.equal_range(it->first);
-        for (auto local_it = range.first; local_it != range.second; ++local_it){
-            if (number_relations >= MAX_SONS){
-                cout << "Mas de 2 padres: " << it->second << endl;
-            }
-            
-            ++number_relations;
-            
+    for (unsigned int node = 0; node < parents.count.size(); ++node) {
+        if (parents.count[node] > MAX_PARENTS) {
+            cout << "Mas de 2 padres: " << parents.cables[parents.offset[node]] << endl;
         }
-        
-        it = range.second;
     }
 }
 
@@ -95,6 +123,11 @@ void CarpPurkinje::setAttributesValues() {
     try {
         conductivity = stof(line);
     } catch (...) {}
+    
+    getline(file, line);
+    try {
+        weld_tolerance = stod(line);
+    } catch (...) {}
 }
 
 /**
@@ -111,69 +144,358 @@ void CarpPurkinje::createDefaultConfigFile() {
     
     file << conductivity << " #Conductividad en Omh por cm de las fibras.\n";
     
+    file << weld_tolerance << " #Distancia maxima entre extremos de cables que se unen en un nodo. 0 si deben ser iguales.\n";
+    
     file << "         #El orden de las lineas es importante.\n" << flush;
     file.close();
 }
 
 /**
  * Función que itera sobra cada una de las fibras de Purkinje y populando sus
- * relaciones con las otras fibras.
+ * relaciones con las otras fibras. Los extremos de cada cable se traducen una
+ * única vez a su nodo, de forma que dos cables estan relacionados si uno
+ * termina en el mismo nodo en el que comienza el otro. Si la tolerancia de
+ * unión es 0 los extremos solo comparten nodo si sus coordenadas son iguales,
+ * si no se unen los que esten a esa distancia o menos.
  **/
 void CarpPurkinje::calcRelations() {
     
-    vector<double> fiber;
-    vector<double> coords_beg, coords_end;
-    size_t last_index;
+    size_t cables_amount = elements->size();
+    cable_begin.resize(cables_amount);
+    cable_end.resize(cables_amount);
+    cable_origin.resize(cables_amount);
+    
+    //Extremos de cada cable: el comienzo en las posiciones pares y el final en las impares
+    std::pmr::vector<unsigned int> endpoints(2 * cables_amount, cable_begin.get_allocator());
+    visitDataset(elements, [&](auto& typed_elements) {
+        for (size_t i = 0; i < cables_amount; ++i) {
+            auto fiber = typed_elements.getRow(i);
+            size_t last_index = fiber.size() - 1;
+            
+            cable_origin[i] = fiber[0];
+            endpoints[2 * i] = fiber[0];
+            endpoints[2 * i + 1] = fiber[last_index];
+        }
+    });
     
-    //size_t number_of_elements = elements->size();
-    for (size_t i = 0; i < elements->size(); ++i) {
-        elements->getData(i, fiber);
-        last_index = fiber.size() - 1;
-        
-        points->getData(fiber[0], coords_beg);
-        points->getData(fiber[last_index], coords_end);
+    if (weld_tolerance > 0) {
+        weldNodes(endpoints);
+    }
+    else {
+        //Tabla de direccionamiento abierto con el nodo de cada coordenada
+        size_t table_size = 1;
+        while (table_size < 2 * endpoints.size())
+            table_size <<= 1;
+        std::pmr::vector<unsigned int> table(table_size, NO_NODE, cable_begin.get_allocator());
         
-        searchParents.insert(pair< vector<double>, unsigned int>(coords_end, i));
-        searchSons.insert(pair< vector<double>, unsigned int>( coords_beg, i));
+        for (auto& point : endpoints) {
+            point = findNode(point, table);
+        }
     }
+    
+    for (size_t i = 0; i < cables_amount; ++i) {
+        cable_begin[i] = endpoints[2 * i];
+        cable_end[i] = endpoints[2 * i + 1];
+    }
+    
+    buildNodeCables(sons, cable_begin);
+    buildNodeCables(parents, cable_end);
 }
 
-void CarpPurkinje::removeExtraRelations () {
-
-start_loop:   
-    for (auto it = searchSons.begin(); it != searchSons.end(); ) {
-        unsigned int number_relations = 0;
-        
-        auto range = searchSons.equal_range(it->first);
-        for (auto local_it = range.first; local_it != range.second; ++local_it){
-            if (number_relations >= MAX_SONS){
-                removeExtraSon(local_it->first, local_it->second);
-                goto start_loop;  
+/**
+ * Sustituye cada extremo de cable por su nodo uniendo los que estan a una
+ * distancia menor o igual que la tolerancia de unión. Los extremos se
+ * recorren en orden: cada uno se une al nodo más cercano dentro de la
+ * tolerancia o, si no hay ninguno, pasa a ser un nodo nuevo. Los nodos se
+ * guardan en una rejilla uniforme de celdas del tamaño de la tolerancia, así
+ * que basta con buscar en la celda del extremo y sus 26 vecinas y el coste
+ * es lineal. La celda de cada extremo se calcula en paralelo.
+ * 
+ * @param [in,out]  endpoints   Índices de los puntos de los extremos, al
+ *                              terminar índices de sus nodos.
+ **/
+void CarpPurkinje::weldNodes(std::pmr::vector<unsigned int>& endpoints) {
+    const size_t CHUNK = 4096;
+    //Evita desbordar las celdas con tolerancias muy pequeñas
+    const double MAX_CELL = 4e18;
+    
+    size_t amount = endpoints.size();
+    std::pmr::vector<double> coords(3 * amount, endpoints.get_allocator());
+    std::pmr::vector<int64_t> cells(3 * amount, endpoints.get_allocator());
+    
+    parallelFor((amount + CHUNK - 1) / CHUNK, [&](size_t chunk) {
+        size_t end = min(amount, (chunk + 1) * CHUNK);
+        for (size_t i = chunk * CHUNK; i < end; ++i) {
+            for (unsigned int j = 0; j < 3; ++j) {
+                double coord = points->getValue(endpoints[i], j);
+                double cell = floor(coord / weld_tolerance);
+                coords[3 * i + j] = coord;
+                cells[3 * i + j] = (int64_t) max(-MAX_CELL, min(MAX_CELL, cell));
             }
+        }
+    });
+    
+    //Nodos creados, siguiente nodo de su celda y primer nodo de cada celda.
+    //Como mucho hay un nodo por extremo y se reserva todo antes para que la
+    //arena no acumule la memoria de cada vez que crecen.
+    std::pmr::vector<unsigned int> nodes(endpoints.get_allocator());
+    std::pmr::vector<unsigned int> next(endpoints.get_allocator());
+    nodes.reserve(amount);
+    next.reserve(amount);
+    size_t table_size = 1;
+    while (table_size < 2 * amount)
+        table_size <<= 1;
+    std::pmr::vector<unsigned int> table(table_size, NO_NODE, endpoints.get_allocator());
+    
+    auto findCell = [&](const int64_t cell[3]) {
+        uint64_t hash = 0;
+        for (unsigned int j = 0; j < 3; ++j) {
+            hash = (hash ^ (uint64_t) cell[j]) * 0x9E3779B97F4A7C15ULL;
+            hash ^= hash >> 29;
+        }
+        
+        size_t mask = table_size - 1;
+        size_t slot = hash & mask;
+        while (table[slot] != NO_NODE &&
+               !equal(cell, cell + 3, &cells[3 * nodes[table[slot]]]))
+            slot = (slot + 1) & mask;
+        return slot;
+    };
+    
+    double max_distance = weld_tolerance * weld_tolerance;
+    for (size_t i = 0; i < amount; ++i) {
+        const double* point = &coords[3 * i];
+        const int64_t* cell = &cells[3 * i];
+        
+        unsigned int closest = NO_NODE;
+        double closest_distance = max_distance;
+        
+        int64_t neighbour[3];
+        for (int dx = -1; dx <= 1; ++dx)
+        for (int dy = -1; dy <= 1; ++dy)
+        for (int dz = -1; dz <= 1; ++dz) {
+            neighbour[0] = cell[0] + dx;
+            neighbour[1] = cell[1] + dy;
+            neighbour[2] = cell[2] + dz;
             
-            ++number_relations;
-            
+            for (unsigned int node = table[findCell(neighbour)]; node != NO_NODE; node = next[node]) {
+                const double* other = &coords[3 * nodes[node]];
+                double distance = 0;
+                for (unsigned int j = 0; j < 3; ++j)
+                    distance += (point[j] - other[j]) * (point[j] - other[j]);
+                
+                if (distance < closest_distance ||
+                    (distance == closest_distance && node < closest)) {
+                    closest = node;
+                    closest_distance = distance;
+                }
+            }
+        }
+        
+        if (closest == NO_NODE) {
+            closest = nodes.size();
+            size_t slot = findCell(cell);
+            nodes.push_back(i);
+            next.push_back(table[slot]);
+            table[slot] = closest;
         }
         
-        it = range.second;
+        endpoints[i] = endpoints[nodes[closest]];
     }
     
+    cout << "Extremos unidos: " << amount - nodes.size() << " de " << amount << endl;
 }
 
-void CarpPurkinje::removeExtraSon(vector<double> point, unsigned int cable_id){
-    //Buscamos el primer elemento que sea padre del hijo
-    vector<double> cable_to_divide, point_cable;
+/**
+ * Devuelve el nodo de un punto, es decir, el primer punto con sus mismas
+ * coordenadas. Las coordenadas se comparan por su valor exacto.
+ * 
+ * @param [in]      point   Índice del punto.
+ * @param [in,out]  table   Tabla de direccionamiento abierto con los nodos
+ *                          encontrados hasta ahora. Su tamaño es potencia de 2.
+ * @return El índice del nodo.
+ **/
+unsigned int CarpPurkinje::findNode(unsigned int point, std::pmr::vector<unsigned int>& table) {
+    double coords[3];
+    uint64_t hash = 0;
+    
+    for (unsigned int i = 0; i < 3; ++i) {
+        //Sumar 0.0 convierte -0.0 en 0.0, que son iguales al compararlos
+        coords[i] = points->getValue(point, i) + 0.0;
+        
+        uint64_t bits;
+        memcpy(&bits, &coords[i], sizeof(bits));
+        hash = (hash ^ bits) * 0x9E3779B97F4A7C15ULL;
+        hash ^= hash >> 29;
+    }
+    
+    size_t mask = table.size() - 1;
+    for (size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+        unsigned int node = table[slot];
+        if (node == NO_NODE) {
+            table[slot] = point;
+            return point;
+        }
+        
+        if (points->getValue(node, 0) == coords[0] &&
+            points->getValue(node, 1) == coords[1] &&
+            points->getValue(node, 2) == coords[2])
+            return node;
+    }
+}
+
+/**
+ * Crea el índice CSR que relaciona cada nodo con los cables que comienzan o
+ * terminan en él. Los cables de cada nodo quedan ordenados por su índice.
+ * 
+ * @param [out] node_cables Índice a crear.
+ * @param [in]  cable_nodes Nodo de cada cable (su comienzo o su final).
+ **/
+void CarpPurkinje::buildNodeCables(NodeCables& node_cables, const std::pmr::vector<unsigned int>& cable_nodes) {
+    size_t nodes_amount = points->size();
+    
+    node_cables.count.assign(nodes_amount, 0);
+    node_cables.offset.assign(nodes_amount + 1, 0);
+    
+    for (auto node : cable_nodes) {
+        ++node_cables.offset[node + 1];
+    }
+    for (size_t node = 0; node < nodes_amount; ++node) {
+        node_cables.offset[node + 1] += node_cables.offset[node];
+    }
+    
+    node_cables.cables.resize(cable_nodes.size());
+    for (size_t cable = 0; cable < cable_nodes.size(); ++cable) {
+        unsigned int node = cable_nodes[cable];
+        node_cables.cables[node_cables.offset[node] + node_cables.count[node]++] = cable;
+    }
+}
+
+/**
+ * Añade al índice un nodo nuevo, que debe de ser el último punto creado.
+ * 
+ * @param [in,out]  node_cables Índice al que se añade.
+ * @param [in]      capacity    Número de cables que se le podrán añadir.
+ * @return El índice del nodo.
+ **/
+unsigned int CarpPurkinje::addNode(NodeCables& node_cables, unsigned int capacity) {
+    unsigned int node = node_cables.count.size();
+    
+    node_cables.count.push_back(0);
+    node_cables.cables.resize(node_cables.cables.size() + capacity, 0);
+    node_cables.offset.push_back(node_cables.cables.size());
+    
+    return node;
+}
+
+/**
+ * Reserva memoria para añadir nodos al índice sin que tenga que crecer.
+ * 
+ * @param [in,out]  node_cables Índice en el que se reserva.
+ * @param [in]      nodes       Número de nodos que se van a añadir.
+ * @param [in]      capacity    Número máximo de cables de cada nodo nuevo.
+ **/
+void CarpPurkinje::reserveNodes(NodeCables& node_cables, size_t nodes, unsigned int capacity) {
+    node_cables.count.reserve(node_cables.count.size() + nodes);
+    node_cables.offset.reserve(node_cables.offset.size() + nodes);
+    node_cables.cables.reserve(node_cables.cables.size() + nodes * capacity);
+}
+
+/**
+ * Añade un cable a un nodo del índice, detrás de los que ya tiene.
+ * 
+ * @param [in,out]  node_cables Índice al que se añade.
+ * @param [in]      node        Nodo.
+ * @param [in]      cable       Cable a añadir.
+ **/
+void CarpPurkinje::addRelation(NodeCables& node_cables, unsigned int node, unsigned int cable) {
+    unsigned int position = node_cables.offset[node] + node_cables.count[node];
+    
+    if (position >= node_cables.offset[node + 1]) {
+        cout << "Error: el nodo " << node << " no admite mas cables." << endl;
+        return;
+    }
+    
+    node_cables.cables[position] = cable;
+    ++node_cables.count[node];
+}
+
+/**
+ * Separa los hijos y los padres que sobran en los nodos con más de los que
+ * admite CARP. Separar un hijo no cambia el número de padres de ningún nodo
+ * ni añade hijos a los nodos existentes, y separar un padre no cambia el
+ * número de hijos ni añade padres a los nodos existentes. Los nodos nuevos
+ * nunca tienen de más, así que basta con recorrer una única vez la lista de
+ * nodos con hijos o padres de más, en orden.
+ **/
+void CarpPurkinje::removeExtraRelations () {
+    
+    //La lista de nodos a separar es temporal, así que no se reserva en la arena
+    vector<unsigned int> worklist;
+    size_t splits = 0;
+    for (unsigned int node = 0; node < sons.count.size(); ++node) {
+        if (sons.count[node] > MAX_SONS || parents.count[node] > MAX_PARENTS)
+            worklist.push_back(node);
+        if (sons.count[node] > MAX_SONS)
+            splits += sons.count[node] - MAX_SONS;
+        if (parents.count[node] > MAX_PARENTS)
+            splits += parents.count[node] - MAX_PARENTS;
+    }
+    
+    //Cada separación añade un punto, un cable de dos puntos y un nodo a cada
+    //índice. Se reserva todo antes porque en la arena cada vez que un vector
+    //crece su memoria anterior no se recupera.
+    points->reserve(splits, 3 * splits);
+    elements->reserve(splits, 2 * splits);
+    cable_origin.reserve(cable_origin.size() + splits);
+    cable_begin.reserve(cable_begin.size() + splits);
+    cable_end.reserve(cable_end.size() + splits);
+    reserveNodes(sons, splits, MAX_SONS);
+    reserveNodes(parents, splits, MAX_PARENTS);
+    
+    for (auto node : worklist) {
+        while (sons.count[node] > MAX_SONS) {
+            //Se separa el más antiguo de los hijos que sobran
+            unsigned int position = sons.offset[node] + sons.count[node] - 1 - MAX_SONS;
+            if (!removeExtraSon(node, sons.cables[position]))
+                break;
+        }
+        while (parents.count[node] > MAX_PARENTS) {
+            //Se separa el más antiguo de los padres que sobran
+            unsigned int position = parents.offset[node] + parents.count[node] - 1 - MAX_PARENTS;
+            if (!removeExtraParent(node, parents.cables[position]))
+                break;
+        }
+    }
+    
+}
+
+/**
+ * Separa un hijo de un nodo con demasiados hijos. Se divide el último tramo
+ * del último cable que se ha añadido como padre del nodo, y el hijo pasa a
+ * comenzar en el nuevo punto. El tramo se divide tal y como estaba al leer el
+ * fichero aunque el padre ya se haya separado de otro nodo, para que el
+ * resultado no dependa del orden en el que se recorren los nodos.
+ * 
+ * @param [in]  node        Nodo con demasiados hijos.
+ * @param [in]  cable_id    Hijo a separar.
+ * @return false si el nodo no tiene ningún padre que dividir.
+ **/
+bool CarpPurkinje::removeExtraSon(unsigned int node, unsigned int cable_id){
+    vector<double> cable_to_divide, point_cable, point;
     size_t penultimate_point_index;
     
-    //Lo buscamos en la otra tabla
-    auto search = searchParents.find(point);
-    if (search != searchParents.end()){
+    if (parents.count[node] > 0){
         
-        unsigned int parent_index = search->second;
+        unsigned int parent_index = parents.cables[parents.offset[node] + parents.count[node] - 1];
         
         elements->getData(parent_index, cable_to_divide);
         penultimate_point_index = cable_to_divide.size() - 2;
-        points->getData(cable_to_divide[penultimate_point_index], point_cable);
+        if (penultimate_point_index == 0)
+            points->getData(cable_origin[parent_index], point_cable);
+        else
+            points->getData(cable_to_divide[penultimate_point_index], point_cable);
+        points->getData(node, point);
         
         size_t new_point_index = createNewPoint(point_cable, point, 0.9);
         
@@ -183,61 +505,162 @@ void CarpPurkinje::removeExtraSon(vector<double> point, unsigned int cable_id){
         
     }
     else {
-        cout << "Error" << endl;
+        cout << "Error: el nodo " << node << " tiene mas de dos hijos y ningun padre." << endl;
+        return false;
     }
+    
+    return true;
 }
 
-void CarpPurkinje::eraseRelation (unordered_multimap< std::vector<double>, unsigned int, MyHash>& hash, vector<double> key, unsigned int value){
-    bool is_found = false;
-    
-    auto search = hash.equal_range(key);
-    auto it = search.first;
-    while (!is_found && search.second != it){
-        if (it->second == value){
-            hash.erase(it);
-            is_found = true;
-        }
-        else
-            ++it;
+/**
+ * Separa un padre de un nodo con demasiados padres. Se divide el primer tramo
+ * del último cable que se ha añadido como hijo del nodo, y el padre pasa a
+ * terminar en el nuevo punto, al que también llega un nuevo cable desde el
+ * nodo.
+ * 
+ * @param [in]  node        Nodo con demasiados padres.
+ * @param [in]  cable_id    Padre a separar.
+ * @return false si el nodo no tiene ningún hijo que dividir.
+ **/
+bool CarpPurkinje::removeExtraParent(unsigned int node, unsigned int cable_id){
+    vector<double> cable_to_divide, point_cable, point;
+    
+    if (sons.count[node] == 0){
+        cout << "Error: el nodo " << node << " tiene mas de dos padres y ningun hijo." << endl;
+        return false;
+    }
+    
+    unsigned int son_index = sons.cables[sons.offset[node] + sons.count[node] - 1];
+    if (son_index == cable_id){
+        cout << "Error: el cable " << cable_id << " comienza y termina en el nodo " << node << "." << endl;
+        return false;
+    }
+    
+    elements->getData(son_index, cable_to_divide);
+    points->getData(cable_to_divide[1], point_cable);
+    points->getData(node, point);
+    
+    size_t new_point_index = createNewPoint(point, point_cable, 0.1);
+    
+    size_t new_cable_index = createNewElement(cable_id, son_index, new_point_index, true);
+    
+    addParentRelations(cable_id, new_cable_index, son_index);
+    
+    return true;
+}
+
+/**
+ * Quita un cable de un nodo del índice manteniendo el orden del resto.
+ * 
+ * @param [in,out]  node_cables Índice del que se quita.
+ * @param [in]      node        Nodo.
+ * @param [in]      cable       Cable a quitar.
+ **/
+void CarpPurkinje::eraseRelation (NodeCables& node_cables, unsigned int node, unsigned int cable){
+    auto begin = node_cables.cables.begin() + node_cables.offset[node];
+    auto end = begin + node_cables.count[node];
+    
+    auto search = find(begin, end, cable);
+    if (search != end){
+        copy(search + 1, end, search);
+        --node_cables.count[node];
     }
     
 }
 
+/**
+ * Actualiza las relaciones tras dividir un cable. El cable dividido termina
+ * ahora en el nuevo punto, del que salen el nuevo cable y el hijo separado, y
+ * el nuevo cable termina donde terminaba el cable dividido.
+ * 
+ * @param [in]  origin_id       Cable dividido.
+ * @param [in]  new_cable_id    Nuevo cable.
+ * @param [in]  end_id          Hijo que se ha separado.
+ **/
 void CarpPurkinje::addRelations (unsigned int origin_id, unsigned int new_cable_id, unsigned int end_id) {
     
-    vector<double> new_point_beg, new_point_end;
-    vector<double> new_cable;
+    unsigned int junction = cable_begin[end_id];
+    
+    addNode(parents, 1);
+    unsigned int new_node = addNode(sons, MAX_SONS);
     
-    elements->getData(new_cable_id, new_cable);
-    points->getData(new_cable[0], new_point_beg);
-    points->getData(new_cable[1], new_point_end);
+    addRelation(parents, new_node, origin_id);
+    addRelation(parents, junction, new_cable_id);
     
-    searchParents.insert(pair< vector<double>, unsigned int>(new_point_beg, origin_id));
-    searchParents.insert(pair< vector<double>, unsigned int>(new_point_end, new_cable_id));
+    addRelation(sons, new_node, new_cable_id);
+    addRelation(sons, new_node, end_id);
     
-    searchSons.insert(pair< vector<double>, unsigned int>(new_point_beg, new_cable_id));
-    searchSons.insert(pair< vector<double>, unsigned int>(new_point_beg, end_id));
+    cable_end[origin_id] = new_node;
+    cable_begin[end_id] = new_node;
+    cable_begin.push_back(new_node);
+    cable_end.push_back(junction);
+    cable_origin.push_back(new_node);
     
 }
 
-size_t CarpPurkinje::createNewElement(unsigned int id_attach_end, unsigned int id_attach_beg, unsigned int attach_point_id){
+/**
+ * Actualiza las relaciones tras separar un padre. El hijo dividido comienza
+ * ahora en el nuevo punto, al que llegan el padre separado y el nuevo cable,
+ * y el nuevo cable comienza donde comenzaba el hijo dividido.
+ * 
+ * @param [in]  origin_id       Padre que se ha separado.
+ * @param [in]  new_cable_id    Nuevo cable.
+ * @param [in]  end_id          Hijo dividido.
+ **/
+void CarpPurkinje::addParentRelations (unsigned int origin_id, unsigned int new_cable_id, unsigned int end_id) {
+    
+    unsigned int junction = cable_begin[end_id];
+    
+    unsigned int new_node = addNode(parents, MAX_PARENTS);
+    addNode(sons, 1);
+    
+    addRelation(parents, new_node, origin_id);
+    addRelation(parents, new_node, new_cable_id);
+    
+    addRelation(sons, junction, new_cable_id);
+    addRelation(sons, new_node, end_id);
+    
+    cable_end[origin_id] = new_node;
+    cable_begin[end_id] = new_node;
+    cable_begin.push_back(junction);
+    cable_end.push_back(new_node);
+    cable_origin.push_back(junction);
+    
+}
+
+/**
+ * Une el final de un cable y el comienzo de otro en un punto nuevo y crea el
+ * cable que completa la conexión. Si se separa un hijo el nuevo cable va del
+ * nuevo punto al antiguo comienzo del hijo, y si se separa un padre va del
+ * antiguo comienzo del hijo al nuevo punto.
+ * 
+ * @param [in]  id_attach_end   Cable que pasa a terminar en el nuevo punto.
+ * @param [in]  id_attach_beg   Cable que pasa a comenzar en el nuevo punto.
+ * @param [in]  attach_point_id Nuevo punto.
+ * @param [in]  to_point        Indica si el nuevo cable termina en el nuevo punto.
+ * @return El índice del nuevo cable.
+ **/
+size_t CarpPurkinje::createNewElement(unsigned int id_attach_end, unsigned int id_attach_beg, unsigned int attach_point_id, bool to_point){
     vector<double> cable_attach_end, cable_attach_beg, new_cable;
-    vector<double> point_end, point_beg;
     
     elements->getData(id_attach_end, cable_attach_end);
     size_t last_index = cable_attach_end.size() - 1;
     
     elements->getData(id_attach_beg, cable_attach_beg);
     
-    new_cable.push_back(attach_point_id);
-    new_cable.push_back(cable_attach_beg[0]);
+    if (to_point) {
+        new_cable.push_back(cable_attach_beg[0]);
+        new_cable.push_back(attach_point_id);
+    }
+    else {
+        new_cable.push_back(attach_point_id);
+        new_cable.push_back(cable_attach_beg[0]);
+    }
     
-    points->getData(cable_attach_end[last_index], point_end);
-    eraseRelation(searchParents, point_end, id_attach_end);
+    eraseRelation(parents, cable_end[id_attach_end], id_attach_end);
     cable_attach_end[last_index] = attach_point_id;
     
-    points->getData(cable_attach_beg[0], point_beg);
-    eraseRelation(searchSons, point_beg, id_attach_beg);
+    eraseRelation(sons, cable_begin[id_attach_beg], id_attach_beg);
     cable_attach_beg[0] = attach_point_id;
     
     elements->modifyData(id_attach_end, cable_attach_end);
@@ -305,276 +728,141 @@ size_t CarpPurkinje::createNewPoint (vector<double>& origin, vector<double>& end
 }
 
 /**
- * Función que escribe los datos necesarios y con la sintaxis adecuada a
- * cualquier tipo de "output stream". En el caso de no exisir ningún punto no 
- * crea el fichero.
- * 
- * @param [in,out]  where   "Output stream" en el que se escribirá la info.
+ * Agrupa los cables en las cadenas que se escriben como un único cable. Un
+ * nodo con un solo padre y un solo hijo no es una bifurcación, así que si se
+ * unen las cadenas los cables que pasan por él se juntan hasta llegar a una
+ * bifurcación, una hoja o la raíz. Si no se unen cada cable es una cadena.
+ * Las cadenas se numeran por su primer cable, y los ciclos sin bifurcaciones
+ * comienzan en su cable de menor índice.
  **/
-void CarpPurkinje::print(std::ostream& where) const{
+void CarpPurkinje::buildChains() {
+    size_t cables_amount = cable_begin.size();
     
-    unsigned int num_cables = elements->size();
-    unsigned int nodes_amount;
-    vector<double> nodes;
-    vector<double> node_coords;
+    cable_chain.assign(cables_amount, NO_NODE);
+    chain_offset.assign(1, 0);
+    chain_cables.clear();
+    chain_cables.reserve(cables_amount);
     
-    where << num_cables << "\n";
-    where << "########################################" << "\n";
+    auto isLink = [&](unsigned int node) {
+        return merge_chains && parents.count[node] == 1 && sons.count[node] == 1;
+    };
     
-    cout << num_cables << endl;
-    for (unsigned int i = 0; i < num_cables; ++i){
-        
-        elements->getData(i, nodes);
-        nodes_amount = nodes.size();
-        
-        where << "Cable " << i << "\n";
-        /*where << fiber.parents[0] << " " << fiber.parents[1] << "\n";
-        where << fiber.sons[0] << " " << fiber.sons[1] << "\n";*/
-        printRelations(where, nodes);
-        where << nodes_amount << "\n";
-        where << cable_size << "\n";
-        where << gap_resistance << "\n";
-        where << conductivity << "\n";
+    auto addChain = [&](unsigned int cable) {
+        unsigned int chain = chain_offset.size() - 1;
         
-        for (unsigned int j = 0; j < nodes_amount; ++j){
-            points->getData(nodes[j], node_coords);
-            for (auto a : node_coords)
-                where << a << " ";
-            where << "\n";
+        while (cable_chain[cable] == NO_NODE) {
+            cable_chain[cable] = chain;
+            chain_cables.push_back(cable);
+            
+            unsigned int node = cable_end[cable];
+            if (!isLink(node))
+                break;
+            cable = sons.cables[sons.offset[node]];
         }
-        
-        where << "########################################" << "\n";
-        
-    }
-    
-    where << "\0";
-}
-
-void CarpPurkinje::printRelations(std::ostream& where, vector<double> cable) const{
-    
-    vector<double> coords_beg, coords_end;
-    size_t last_index = cable.size() - 1;
-    
-    PurkinjeRelations pr;
+        chain_offset.push_back(chain_cables.size());
+    };
     
-    points->getData(cable[0], coords_beg);
-    points->getData(cable[last_index], coords_end);
-    
-    auto range = searchParents.equal_range(coords_beg);
-    int i = 0;
-    for (auto it = range.first; it != range.second; ++it){
-        pr.parents[i] = it->second;
-        ++i;
-    }
-    
-    range = searchSons.equal_range(coords_end);
-    i = 0;
-    for (auto it = range.first; it != range.second; ++it){
-        pr.sons[i] = it->second;
-        ++i;
+    for (unsigned int cable = 0; cable < cables_amount; ++cable) {
+        if (!isLink(cable_begin[cable]))
+            addChain(cable);
     }
-    
-    if (pr.parents[1] == -1){
-        where << pr.parents[0] << " " << pr.parents[1];
-    }
-    else if (pr.parents[0] < pr.parents[1]){
-        where << pr.parents[0] << " " << pr.parents[1];
-    }
-    else
-        where << pr.parents[1] << " " << pr.parents[0];
-    where << "\n";
-    
-    if (pr.sons[1] == -1){
-        where << pr.sons[0] << " " << pr.sons[1];
+    //Solo quedan cables en ciclos sin ninguna bifurcación
+    for (unsigned int cable = 0; cable < cables_amount; ++cable) {
+        if (cable_chain[cable] == NO_NODE)
+            addChain(cable);
     }
-    else if (pr.sons[0] < pr.sons[1]){
-        where << pr.sons[0] << " " << pr.sons[1];
-    }
-    else
-        where << pr.sons[1] << " " << pr.sons[0];
-    where << "\n";
-}
-
-
-/*
- * 
- * size_t CarpPurkinje::createNewCables (unsigned int index_new_point, unsigned int cable_to_divide_index, unsigned int index_cable_attach){  
-    
-    vector<double> cable_to_divide;
-    elements->getData(cable_to_divide_index, cable_to_divide);
-    size_t last_index = cable_to_divide.size() - 1;
-    
-    vector<double> new_cable;
-    new_cable.push_back(index_new_point);
-    new_cable.push_back(cable_to_divide[last_index]);
-    elements->addData(new_cable);
-    
-    cable_to_divide[last_index] = index_new_point;
-    elements->modifyData(cable_to_divide_index, cable_to_divide);
-    
-    vector<double> new_cable_son;
-    elements->getData(index_cable_attach, new_cable_son);
-    new_cable_son[0] = index_new_point;
-    elements->modifyData(index_cable_attach, new_cable_son);
-    
-    return (elements->size()-1);
 }
- * void CarpPurkinje::changePurkinje(unsigned int cable_index, unsigned int index_cable_attach) {
-    size_t new_point_index = createNewPoint(cable_index);
-    size_t new_cable_index = createNewCables (new_point_index, cable_index, index_cable_attach);
-    changeSearchRelations (cable_index , new_cable_index);
-    changePurkinjeRaltions(cable_index, new_cable_index, index_cable_attach);
 
-    vector<double> new_cable;
-    elements->getData(new_cable_index, new_cable);
-    unsigned int last_index = new_cable.size() - 1;
-    
-    vector<double> coords_beg, coords_end;
-    points->getData(new_cable[0], coords_beg);
-    points->getData(new_cable[last_index], coords_end);
-    
-    searchParents.insert(pair< vector<double>, unsigned int>(coords_end, new_cable_index));
-    searchSons.insert(pair< vector<double>, unsigned int>( coords_beg, new_cable_index));
-    
-}
- void CarpPurkinje::divideCableeee(unsigned int cable_to_divide_index, unsigned int id_hijo) {
-    
-    vector<double> cable_to_divide;
-    vector<double> origin_coords, end_coords;
-    vector<double> vector_coords;
-    vector<double> new_point_coords;
-    
-    ///////////////////////////
-    elements->getData(cable_to_divide_index, cable_to_divide);
-    size_t last_index = cable_to_divide.size() - 1;
-    size_t penultimate_index = last_index -1;
-    
-    points->getData(cable_to_divide[penultimate_index], origin_coords);
-    points->getData(cable_to_divide[last_index], end_coords);
-    std::trasform(end_coords.begin(), end_coords.end(), origin_coords.begin(), vector_coords.begin(), std::minus<double>());
-    
-    for (int i = 0; i < 3; ++i){
-        vector_coords[i] *= 0.9;//
-    }
-    std::transform(origin_coords.begin(), origin_coords.end(), vector_coords.begin(), new_point_coords.begin(), std::plus<double>());
-    
-    points->addData(new_point_coords);
-    size_t index_new_point = points->size()-1;
-    ////////////////////////////////
+/**
+ * Crea el grafo de cables de salida una vez divididos y agrupados en cadenas:
+ * para cada cadena las dos que terminan donde comienza (padres) y las dos que
+ * comienzan donde termina (hijos), ordenadas de menor a mayor y con -1 en los
+ * huecos vacios. Así las relaciones de cualquier cable se consultan en tiempo
+ * constante y el fichero se escribe recorriendo los cables en orden.
+ **/
+void CarpPurkinje::buildCableGraph() {
+    size_t chains_amount = chain_offset.size() - 1;
+    relations.assign(chains_amount, PurkinjeRelations());
     
-    ////////////////////////////////////
-    vector<double> new_cable;
-    new_cable.push_back(index_new_point);
-    new_cable.push_back(cable_to_divide[last_index]);
-    elements->addData(new_cable);
-    size_t index_new_element = elements->size()-1;
-    ////////////////////////////////////
-    
-    ////////////////////////////////////
-    cable_to_divide[last_index] = index_new_point;
-    elements->modifyData(cable_index, cable_to_divide);
-    /////////////////////////////////////
-    
-    /////////////////////////////////////
-    auto search = searchParents.equal_range(end_coords);
-    bool is_found = false;
-    auto it = search.first;
-    while (!is_found && search.second != it) {
-        if (it->second == cable_index){
-            searchParents.erase(it);
-            is_found = true;
+    for (size_t chain = 0; chain < chains_amount; ++chain) {
+        PurkinjeRelations& pr = relations[chain];
+        
+        unsigned int node = cable_begin[chain_cables[chain_offset[chain]]];
+        unsigned int amount = min(parents.count[node], MAX_PARENTS);
+        for (unsigned int i = 0; i < amount; ++i){
+            pr.parents[i] = cable_chain[parents.cables[parents.offset[node] + i]];
         }
-        else 
-            ++it;
+        if (pr.parents[1] != -1 && pr.parents[1] < pr.parents[0])
+            swap(pr.parents[0], pr.parents[1]);
+        
+        node = cable_end[chain_cables[chain_offset[chain + 1] - 1]];
+        amount = min(sons.count[node], MAX_SONS);
+        for (unsigned int i = 0; i < amount; ++i){
+            pr.sons[i] = cable_chain[sons.cables[sons.offset[node] + i]];
+        }
+        if (pr.sons[1] != -1 && pr.sons[1] < pr.sons[0])
+            swap(pr.sons[0], pr.sons[1]);
     }
-    /////////////////////////////////////////////////
-    
-    ///////////////////////////////
-    PurkinjeRelations aux;
-    aux.parents[0] = cable_index;
-    aux.sons[0] = purkinje_fiber[cable_index].sons[0];
-    aux.sons[1] = purkinje_fiber[cable_index].sons[1];
-    purkinje_fiber.push_back(aux);
-    purkinje_fiber[cable_index].sons[0] = id_hijo;
-    purkinje_fiber[cable_index].sons[1] = index_new_element;
-    ///////////////////////////////
-    
-    ///////////////////////////////////////////////
-    vector<double> new_cable_son;
-    elements->getData(id_hijo, new_cable_son);
-    new_cable_son[0] = index_new_point;
-    elements->modifyData(id_hijo, new_cable_son);
-    ////////////////////////////////////////////////////
-}
- * 
- * 
- * void CarpPurkinje::changePurkinjeRaltions (unsigned int cable_to_divide_index, unsigned int new_cable_index, unsigned int index_cable_attach) {
-    PurkinjeRelations aux;
-    aux.parents[0] = cable_to_divide_index;
-    aux.sons[0] = purkinje_fiber[cable_to_divide_index].sons[0];
-    aux.sons[1] = purkinje_fiber[cable_to_divide_index].sons[1];
-    purkinje_fiber.push_back(aux);
-    purkinje_fiber[cable_to_divide_index].sons[0] = index_cable_attach;
-    purkinje_fiber[cable_to_divide_index].sons[1] = new_cable_index;
 }
+
+/**
+ * Función que escribe los datos necesarios y con la sintaxis adecuada a
+ * cualquier tipo de "output stream". En el caso de no exisir ningún punto no 
+ * crea el fichero. Cada cadena se escribe como un cable con los puntos de
+ * todos sus cables, sin repetir el punto en el que se unen. Las relaciones se
+ * leen del grafo de cables y los índices y coordenadas directamente en su
+ * tipo nativo, sin copiarlos, y se escriben a través de un OutputBuffer.
  * 
- * 
- * void CarpPurkinje::changeSearchRelations (unsigned int cable_to_divide_index, unsigned int new_cable_index) {
-    
-    vector<double> cable_to_divide;
-    elements->getData(cable_to_divide_index, cable_to_divide);
-    size_t last_index = cable_to_divide.size() - 1;
-    
-    vector<double> end_coords;
-    points->getData(cable_to_divide[last_index], end_coords);
-    
-    auto search = searchParents.equal_range(end_coords);
-    bool is_found = false;
-    auto it = search.first;
-    while (!is_found && search.second != it) {
-        if (it->second == cable_to_divide_index){
-            searchParents.erase(it);
-            is_found = true;
-        }
-        else 
-            ++it;
-    }
+ * @param [in,out]  where   "Output stream" en el que se escribirá la info.
+ **/
+void CarpPurkinje::print(std::ostream& where) const{
     
-    searchParents.insert(pair< vector<double>, unsigned int>(end_coords, new_cable_index));
+    unsigned int num_cables = chain_offset.size() - 1;
     
-    void CarpPurkinje::calcularVecinos2() {
+    OutputBuffer buffer(where);
+    buffer << num_cables << "\n";
+    buffer << "########################################" << "\n";
     
-    vector<double> fiber;
-    vector<double> coords_beg, coords_end;
-    size_t last_index;
+    cout << num_cables << endl;
+    visitDataset(elements, [&](auto& typed_elements) {
+        visitDataset(points, [&](auto& typed_points) {
+            for (unsigned int i = 0; i < num_cables; ++i){
+                
+                unsigned int first = chain_offset[i];
+                unsigned int last = chain_offset[i + 1];
+                
+                size_t nodes_amount = 1;
+                for (unsigned int j = first; j < last; ++j){
+                    nodes_amount += typed_elements.getRow(chain_cables[j]).size() - 1;
+                }
+                
+                const PurkinjeRelations& pr = relations[i];
+                
+                buffer << "Cable " << i << "\n";
+                buffer << pr.parents[0] << " " << pr.parents[1] << "\n";
+                buffer << pr.sons[0] << " " << pr.sons[1] << "\n";
+                buffer << nodes_amount << "\n";
+                buffer << cable_size << "\n";
+                buffer << gap_resistance << "\n";
+                buffer << conductivity << "\n";
+                
+                for (unsigned int j = first; j < last; ++j){
+                    auto nodes = typed_elements.getRow(chain_cables[j]);
+                    
+                    //El primer punto de cada cable es el último del anterior
+                    for (size_t k = (j == first ? 0 : 1); k < nodes.size(); ++k){
+                        for (auto a : typed_points.getRow(nodes[k]))
+                            buffer << a << " ";
+                        buffer << "\n";
+                    }
+                }
+                
+                buffer << "########################################" << "\n";
+                
+            }
+        });
+    });
+    buffer.flush();
     
-    //Carefull
-    size_t number_of_elements = elements->size();
-    cout << number_of_elements << endl;
-    for (size_t i = 0; i < number_of_elements; ++i) {
-        elements->getData(i, fiber);
-        last_index = elements->getDataDimension(i) - 1;
-        
-        points->getData(fiber[0], coords_beg);
-        points->getData(fiber[last_index], coords_end);
-
-        
-        auto search =  searchParents.equal_range(coords_beg);
-        for (auto it = search.first; it != search.second; ++it){
-            setFathers(i, it->second); //Se ha encontrado un padre de esta fibra
-            setSons (it->second, i);  //Y los hijos
-        }
-        
-        search = searchSons.equal_range(coords_end);
-        for (auto it = search.first; it != search.second; ++it){
-            setSons(i, it->second); //Se ha encontrado un hijo de esta fibra
-            setFathers (it->second, i);
-        }
-        
-        searchParents.insert(pair< vector<double>, unsigned int>(coords_end, i));
-        searchSons.insert(pair< vector<double>, unsigned int>( coords_beg, i));
-        
-    }
-}
+    where << "\0";
 }
- */
\ No newline at end of file
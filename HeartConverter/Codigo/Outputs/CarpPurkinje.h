@@ -15,30 +15,38 @@
 #include <string>
 #include <iostream>
 #include <vector>
-#include <unordered_map>
+#include <memory_resource>
 #include <algorithm>
-#include <functional>
 #include "../Datasets/DatasetAbstract.h"
+#include "../Datasets/DatasetContext.h"
 
 #include "AbstractFile.h"
 
 class CarpPurkinje : public AbstractFile{
 public:
 
-    CarpPurkinje (const std::string&);
+    CarpPurkinje (const std::string&, DatasetContext&, bool merge_chains = false);
     
     void print(std::ostream&) const;    
     
+    static std::vector<std::string> getRequiredArrays();
+    
 private:
     
-    typedef struct MyHash {
-        size_t operator()(const std::vector<double> &val) const {
-            size_t x = std::hash<double>()(val[0]);
-            size_t y = std::hash<double>()(val[1]);
-            size_t z = std::hash<double>()(val[2]);
-            return ((x ^ (y << 1)) ^ (z << 2) );
-        }
-    } MyHash;
+    /**
+     * Cables que comienzan o terminan en cada nodo, en formato CSR. Un nodo es
+     * el primer punto con unas coordenadas dadas, así que se identifica con
+     * el índice de ese punto. Cada nodo tiene un hueco fijo en cables a partir
+     * de offset[nodo] del que usa count[nodo] posiciones, en el orden en el
+     * que se añadieron los cables.
+     **/
+    typedef struct NodeCables {
+        std::pmr::vector<unsigned int> offset;  ///< Comienzo del hueco de cada nodo y final del último.
+        std::pmr::vector<unsigned int> count;   ///< Número de cables de cada nodo.
+        std::pmr::vector<unsigned int> cables;  ///< Índices de los cables.
+        
+        NodeCables(std::pmr::memory_resource* resource) : offset(resource), count(resource), cables(resource) {}
+    } NodeCables;
     
     void calcRelations();
     void setSons(unsigned int, unsigned int);
@@ -46,15 +54,25 @@ private:
     void setAttributesValues();
     void createDefaultConfigFile();
 
+    unsigned int findNode(unsigned int, std::pmr::vector<unsigned int>&);
+    void weldNodes(std::pmr::vector<unsigned int>&);
+    void buildNodeCables(NodeCables&, const std::pmr::vector<unsigned int>&);
+    unsigned int addNode(NodeCables&, unsigned int);
+    void reserveNodes(NodeCables&, size_t, unsigned int);
+    void addRelation(NodeCables&, unsigned int, unsigned int);
+    
     size_t createNewPoint(std::vector<double>&, std::vector<double>&, float);
     void addRelations (unsigned int, unsigned int, unsigned int);
-    void eraseRelation (std::unordered_multimap< std::vector<double> , unsigned int, MyHash>&, std::vector<double>, unsigned int);
-    void removeExtraSon(std::vector<double>, unsigned int);
-    size_t createNewElement(unsigned int, unsigned int, unsigned int);
+    void eraseRelation (NodeCables&, unsigned int, unsigned int);
+    bool removeExtraSon(unsigned int, unsigned int);
+    bool removeExtraParent(unsigned int, unsigned int);
+    void addParentRelations (unsigned int, unsigned int, unsigned int);
+    size_t createNewElement(unsigned int, unsigned int, unsigned int, bool = false);
     size_t modifyRelations(unsigned int, unsigned int, unsigned int);
     void removeExtraRelations ();
     
-    void printRelations(std::ostream&, std::vector<double>) const;
+    void buildChains();
+    void buildCableGraph();
     
     void printSeveralParents();
     
@@ -72,10 +90,19 @@ private:
     unsigned int cable_size = 75;
     double gap_resistance = 100;
     double conductivity = 0.0006;
+    double weld_tolerance = 0;      ///< Distancia máxima entre extremos que se unen en un nodo.
  
     
-    std::unordered_multimap< std::vector<double> , unsigned int, MyHash> searchSons;
-    std::unordered_multimap< std::vector<double> , unsigned int, MyHash> searchParents;
+    std::pmr::vector<unsigned int> cable_origin;///< Primer punto de cada cable al leer el fichero o al crearlo.
+    std::pmr::vector<unsigned int> cable_begin; ///< Nodo en el que comienza cada cable.
+    std::pmr::vector<unsigned int> cable_end;   ///< Nodo en el que termina cada cable.
+    NodeCables sons;                ///< Cables que comienzan en cada nodo, hijos de los que terminan en él.
+    NodeCables parents;             ///< Cables que terminan en cada nodo, padres de los que comienzan en él.
+    std::pmr::vector<PurkinjeRelations> relations;  ///< Padres e hijos de cada cable de salida.
+    std::pmr::vector<unsigned int> cable_chain;     ///< Cable de salida (cadena) al que pertenece cada cable.
+    std::pmr::vector<unsigned int> chain_offset;    ///< Comienzo de cada cadena en chain_cables y final de la última.
+    std::pmr::vector<unsigned int> chain_cables;    ///< Cables de cada cadena, en orden del primero al último.
+    bool merge_chains;              ///< Indica si se unen los cables sin bifurcaciones entre ellos.
     
     const unsigned int MAX_SONS = 2;
     const unsigned int MAX_PARENTS = 2;
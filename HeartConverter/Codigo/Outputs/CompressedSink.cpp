@@ -0,0 +1,209 @@
+/**
+ * @file CompressedSink.cpp
+ *
+ * Destino de un fichero de salida que comprime los carácteres antes de
+ * pasarlos a otro destino. El fichero se divide en bloques que se comprimen
+ * en paralelo por separado, cada uno como un miembro gzip o una trama zstd
+ * independiente, y se escriben en orden. Un fichero formado por varios
+ * miembros o tramas seguidos es un fichero gzip o zstd válido, así que se
+ * descomprime con gunzip o zstd -d como cualquier otro.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#include "CompressedSink.h"
+#include "../Parallel.h"
+#include <string>
+#include <atomic>
+#include <cstring>
+#include <zlib.h>
+
+#ifdef HAS_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace std;
+
+static const int ZSTD_LEVEL = 3;    ///< Nivel de compresión de zstd, el mismo que usa por defecto.
+
+/**
+ * Indica si se puede comprimir con un formato. zstd solo está disponible si
+ * se ha encontrado la biblioteca al compilar.
+ *
+ * @param [in]  type    Formato: "gzip", "gz", "zstd" o "zst".
+ * @return true si el formato existe y está disponible.
+ **/
+bool CompressedSink::isSupported(const string& type) {
+    if (type == "gzip" || type == "gz")
+        return true;
+
+#ifdef HAS_ZSTD
+    if (type == "zstd" || type == "zst")
+        return true;
+#endif
+
+    return false;
+}
+
+/**
+ * Devuelve la extensión que se añade a los ficheros comprimidos.
+ *
+ * @param [in]  type    Formato de compresión.
+ * @return String con la extensión, vacio si no se comprime.
+ **/
+string CompressedSink::getExtension(const string& type) {
+    if (type == "gzip" || type == "gz")
+        return ".gz";
+    if (type == "zstd" || type == "zst")
+        return ".zst";
+    return "";
+}
+
+/**
+ * Constructor. Cada tanda tiene dos bloques por hilo, para que todos los
+ * hilos trabajen aunque unos bloques se compriman antes que otros.
+ *
+ * @param [in]  where   Destino de los datos comprimidos, pasa a ser de la clase.
+ * @param [in]  type    Formato de compresión.
+ **/
+CompressedSink::CompressedSink(OutputSink* where, const string& type) : where(where) {
+    size_t batch = 2 * getThreadsAmount();
+
+    use_zstd = (type == "zstd" || type == "zst");
+    is_open = where->isOpen();
+    is_closed = false;
+    any_block = false;
+
+    blocks.resize(batch, vector<char>(BLOCK_SIZE));
+    blocks_size.resize(batch, 0);
+    compressed.resize(batch);
+    compressed_size.resize(batch, 0);
+    used_blocks = 0;
+
+    setp(blocks[0].data(), blocks[0].data() + BLOCK_SIZE);
+}
+
+/**
+ * Comprime un bloque como un miembro gzip o una trama zstd.
+ *
+ * @param [in]  index   Índice del bloque en la tanda.
+ * @return false si no se ha podido comprimir.
+ **/
+bool CompressedSink::compressBlock(size_t index) {
+    size_t size = blocks_size[index];
+    vector<char>& output = compressed[index];
+
+#ifdef HAS_ZSTD
+    if (use_zstd) {
+        output.resize(ZSTD_compressBound(size));
+        size_t result = ZSTD_compress(output.data(), output.size(), blocks[index].data(), size, ZSTD_LEVEL);
+        if (ZSTD_isError(result))
+            return false;
+
+        compressed_size[index] = result;
+        return true;
+    }
+#endif
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+
+    //15 bits de ventana más 16 para escribir la cabecera gzip en lugar de zlib
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        return false;
+
+    output.resize(deflateBound(&stream, size));
+    stream.next_in = reinterpret_cast<Bytef*>(blocks[index].data());
+    stream.avail_in = size;
+    stream.next_out = reinterpret_cast<Bytef*>(output.data());
+    stream.avail_out = output.size();
+
+    int result = deflate(&stream, Z_FINISH);
+    compressed_size[index] = stream.total_out;
+    deflateEnd(&stream);
+
+    return result == Z_STREAM_END;
+}
+
+/**
+ * Comprime en paralelo los bloques llenos y los escribe en orden en el
+ * destino.
+ *
+ * @return false si no se ha podido comprimir o escribir algún bloque.
+ **/
+bool CompressedSink::compressBlocks() {
+    atomic<bool> is_correct(true);
+
+    parallelFor(used_blocks, [&](size_t i) {
+        if (!compressBlock(i))
+            is_correct = false;
+    });
+
+    for (size_t i = 0; i < used_blocks && is_correct; ++i) {
+        streamsize size = compressed_size[i];
+        if (where->sputn(compressed[i].data(), size) != size)
+            is_correct = false;
+    }
+
+    any_block = any_block || used_blocks > 0;
+    used_blocks = 0;
+    return is_correct;
+}
+
+/**
+ * Guarda el bloque lleno y continúa en el siguiente. Cuando se llenan todos
+ * los bloques de la tanda se comprimen.
+ *
+ * @return false si no se ha podido comprimir o escribir algún bloque.
+ **/
+bool CompressedSink::flushArea() {
+    bool is_correct = true;
+
+    blocks_size[used_blocks++] = pptr() - pbase();
+    if (used_blocks == blocks.size())
+        is_correct = compressBlocks();
+
+    char* block = blocks[used_blocks].data();
+    setp(block, block + BLOCK_SIZE);
+    return is_correct;
+}
+
+/**
+ * Comprime lo que quede, cierra el destino y libera los bloques. Un fichero
+ * vacío se escribe también como un bloque vacío, para que siga siendo un
+ * fichero comprimido válido.
+ *
+ * @return true si todos los datos se han escrito.
+ **/
+bool CompressedSink::close() {
+    if (is_closed)
+        return is_open;
+    is_closed = true;
+
+    if (is_open) {
+        size_t size = pptr() - pbase();
+        if (size > 0 || (!any_block && used_blocks == 0))
+            blocks_size[used_blocks++] = size;
+
+        if (!compressBlocks())
+            is_open = false;
+    }
+
+    if (!where->close())
+        is_open = false;
+
+    setp(nullptr, nullptr);
+    blocks.clear();
+    compressed.clear();
+    return is_open;
+}
+
+/**
+ * Destructor. Cierra el fichero si no se había cerrado.
+ **/
+CompressedSink::~CompressedSink() {
+    close();
+}
@@ -0,0 +1,60 @@
+/**
+ * @file CompressedSink.h
+ *
+ * Destino de un fichero de salida que comprime los carácteres antes de
+ * pasarlos a otro destino. El fichero se divide en bloques que se comprimen
+ * en paralelo por separado, cada uno como un miembro gzip o una trama zstd
+ * independiente, y se escriben en orden. Un fichero formado por varios
+ * miembros o tramas seguidos es un fichero gzip o zstd válido, así que se
+ * descomprime con gunzip o zstd -d como cualquier otro.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#ifndef COMPRESSEDSINK_H
+#define COMPRESSEDSINK_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "OutputSink.h"
+
+class CompressedSink : public OutputSink {
+public:
+
+    static const size_t BLOCK_SIZE = 1 << 20;   ///< Tamaño de cada bloque sin comprimir, 1 MiB.
+
+    static bool isSupported(const std::string&);
+    static std::string getExtension(const std::string&);
+
+    CompressedSink(OutputSink*, const std::string&);
+
+    bool close() override;
+
+    ~CompressedSink();
+
+protected:
+
+    bool flushArea() override;
+
+private:
+
+    bool compressBlocks();
+    bool compressBlock(size_t);
+
+    std::unique_ptr<OutputSink> where;  ///< Destino de los datos comprimidos.
+    bool use_zstd;                      ///< Indica si se usa zstd en lugar de gzip.
+    bool is_closed;                     ///< Indica si ya se ha cerrado el fichero.
+    bool any_block;                     ///< Indica si se ha escrito algún bloque.
+
+    std::vector<std::vector<char>> blocks;      ///< Bloques sin comprimir de la tanda actual.
+    std::vector<size_t> blocks_size;            ///< Carácteres usados de cada bloque.
+    std::vector<std::vector<char>> compressed;  ///< Bloques comprimidos de la tanda actual.
+    std::vector<size_t> compressed_size;        ///< Tamaño de cada bloque comprimido.
+    size_t used_blocks;                         ///< Bloques llenos de la tanda actual.
+};
+
+#endif /* COMPRESSEDSINK_H */
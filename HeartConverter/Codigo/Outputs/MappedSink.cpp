@@ -0,0 +1,109 @@
+/**
+ * @file MappedSink.cpp
+ *
+ * Destino de un fichero de salida proyectado en memoria (mmap). El fichero
+ * se reserva con un tamaño inicial y los carácteres se escriben directamente
+ * en sus páginas; cuando se llena se duplica su tamaño, y al cerrarlo se
+ * recorta a lo que se ha escrito.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#include "MappedSink.h"
+#include <string>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+/**
+ * Constructor. Crea el fichero, o lo vacía si ya existía, y lo proyecta en
+ * memoria con el tamaño inicial. Si no se puede isOpen() devolverá false.
+ *
+ * @param [in]  file_name   Nombre del fichero.
+ **/
+MappedSink::MappedSink(const string& file_name) {
+    mapping = nullptr;
+    capacity = 0;
+
+    //Una proyección compartida con escritura necesita abrir también para leer
+    descriptor = open(file_name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    is_open = (descriptor >= 0 && resize(INITIAL_SIZE));
+}
+
+/**
+ * Cambia el tamaño del fichero y de su proyección, manteniendo la posición
+ * de escritura. El espacio se reserva en el disco con posix_fallocate, ya
+ * que quedarse sin él al escribir en la proyección terminaría el programa
+ * con SIGBUS en lugar de dar un error.
+ *
+ * @param [in]  size    Nuevo tamaño.
+ * @return false si no se ha podido cambiar el tamaño.
+ **/
+bool MappedSink::resize(size_t size) {
+    size_t used = (mapping == nullptr) ? 0 : pptr() - mapping;
+
+    if (posix_fallocate(descriptor, capacity, size - capacity) != 0)
+        return false;
+
+    void* address;
+    if (mapping == nullptr)
+        address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    else
+        address = mremap(mapping, capacity, size, MREMAP_MAYMOVE);
+
+    if (address == MAP_FAILED)
+        return false;
+
+    mapping = static_cast<char*>(address);
+    capacity = size;
+    madvise(mapping, capacity, MADV_SEQUENTIAL);
+
+    setp(mapping + used, mapping + capacity);
+    return true;
+}
+
+/**
+ * Se llama cuando se ha llenado el fichero. Duplica su tamaño.
+ *
+ * @return false si no se ha podido agrandar el fichero.
+ **/
+bool MappedSink::flushArea() {
+    return resize(2 * capacity);
+}
+
+/**
+ * Elimina la proyección, recorta el fichero a lo escrito y lo cierra.
+ *
+ * @return true si todos los datos se han escrito.
+ **/
+bool MappedSink::close() {
+    if (descriptor < 0)
+        return false;
+
+    if (mapping != nullptr) {
+        size_t used = pptr() - mapping;
+        munmap(mapping, capacity);
+        mapping = nullptr;
+
+        if (ftruncate(descriptor, used) != 0)
+            is_open = false;
+    }
+
+    if (::close(descriptor) != 0)
+        is_open = false;
+
+    descriptor = -1;
+    setp(nullptr, nullptr);
+    return is_open;
+}
+
+/**
+ * Destructor. Cierra el fichero si no se había cerrado.
+ **/
+MappedSink::~MappedSink() {
+    close();
+}
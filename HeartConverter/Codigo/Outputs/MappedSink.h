@@ -0,0 +1,45 @@
+/**
+ * @file MappedSink.h
+ *
+ * Destino de un fichero de salida proyectado en memoria (mmap). El fichero
+ * se reserva con un tamaño inicial y los carácteres se escriben directamente
+ * en sus páginas; cuando se llena se duplica su tamaño, y al cerrarlo se
+ * recorta a lo que se ha escrito.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#ifndef MAPPEDSINK_H
+#define MAPPEDSINK_H
+
+#include <string>
+#include "OutputSink.h"
+
+class MappedSink : public OutputSink {
+public:
+
+    static const size_t INITIAL_SIZE = 1 << 24;    ///< Tamaño inicial del fichero, 16 MiB.
+
+    MappedSink(const std::string&);
+
+    bool close() override;
+
+    ~MappedSink();
+
+protected:
+
+    bool flushArea() override;
+
+private:
+
+    bool resize(size_t);
+
+    int descriptor;     ///< Descriptor del fichero, -1 si está cerrado.
+    char* mapping;      ///< Comienzo de la proyección, nullptr si no hay.
+    size_t capacity;    ///< Tamaño actual del fichero y de la proyección.
+};
+
+#endif /* MAPPEDSINK_H */
@@ -0,0 +1,225 @@
+/**
+ * @file OutputBuffer.h
+ *
+ * Buffer de escritura que comparten los ficheros de salida. Los textos y los
+ * números se escriben en un array de carácteres que se vuelca de una vez en
+ * el "output stream" cuando se llena o al destruir el buffer. Los números se
+ * convierten con std::to_chars, sin pasar por el locale del "output stream":
+ * los enteros directamente y los reales con el formato general (%g) y la
+ * precisión del "output stream", de forma que el resultado es el mismo que
+ * escribiéndolos con el operador <<. Un buffer sin "output stream" guarda todo
+ * en memoria, para que varios hilos escriban cada uno una parte del fichero.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#ifndef OUTPUTBUFFER_H
+#define OUTPUTBUFFER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <charconv>
+#include <cstring>
+#include <type_traits>
+#include <memory>
+#include <algorithm>
+#include "../Parallel.h"
+
+class OutputBuffer {
+public:
+
+    static const size_t DEFAULT_CAPACITY = 1 << 16;    ///< Tamaño por defecto del buffer.
+
+    /**
+     * Constructor.
+     *
+     * @param [in,out]  where       "Output stream" en el que se volcará el buffer.
+     * @param [in]      capacity    Tamaño del buffer.
+     **/
+    OutputBuffer(std::ostream& where, size_t capacity = DEFAULT_CAPACITY)
+        : where(&where), buffer(capacity), used(0), precision(where.precision()) {
+        if (precision < 0)
+            precision = 6;
+    }
+
+    /**
+     * Constructor de un buffer en memoria, que crece según se necesita y
+     * nunca se vuelca.
+     *
+     * @param [in]  precision   Cifras significativas de los números reales.
+     * @param [in]  capacity    Tamaño inicial del buffer.
+     **/
+    OutputBuffer(int precision, size_t capacity = DEFAULT_CAPACITY)
+        : where(nullptr), buffer(capacity), used(0), precision(precision < 0 ? 6 : precision) {
+    }
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    /**
+     * Destructor. Vuelca lo que quede en el buffer.
+     **/
+    ~OutputBuffer() {
+        flush();
+    }
+
+    /**
+     * Escribe un texto.
+     *
+     * @param [in]  text    Texto terminado en '\0'.
+     * @return El propio buffer.
+     **/
+    OutputBuffer& operator<< (const char* text) {
+        return write(text, strlen(text));
+    }
+
+    /**
+     * Escribe un texto.
+     *
+     * @param [in]  text    Texto a escribir.
+     * @return El propio buffer.
+     **/
+    OutputBuffer& operator<< (const std::string& text) {
+        return write(text.data(), text.size());
+    }
+
+    /**
+     * Escribe un número. Los char y bool se escriben como números enteros,
+     * igual que con printable(), por lo que los carácteres sueltos deben de
+     * escribirse como texto.
+     *
+     * @param [in]  value   Número a escribir.
+     * @return El propio buffer.
+     **/
+    template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+    OutputBuffer& operator<< (T value) {
+        reserve(MAX_NUMBER_SIZE + precision);
+
+        char* first = buffer.data() + used;
+        char* last = buffer.data() + buffer.size();
+        std::to_chars_result result;
+
+        if constexpr (std::is_floating_point<T>::value)
+            result = std::to_chars(first, last, value, std::chars_format::general, precision);
+        else if constexpr (std::is_same<T, bool>::value)
+            result = std::to_chars(first, last, (int) value);
+        else
+            result = std::to_chars(first, last, +value);
+
+        used = result.ptr - buffer.data();
+        return *this;
+    }
+
+    /**
+     * Escribe un array de carácteres.
+     *
+     * @param [in]  text    Carácteres a escribir.
+     * @param [in]  size    Número de carácteres.
+     * @return El propio buffer.
+     **/
+    OutputBuffer& write(const char* text, size_t size) {
+        reserve(size);
+        memcpy(buffer.data() + used, text, size);
+        used += size;
+        return *this;
+    }
+
+    /**
+     * Vuelca el contenido del buffer en el "output stream". Un buffer en
+     * memoria no se vacía.
+     **/
+    void flush() {
+        if (where == nullptr)
+            return;
+        if (used > 0)
+            where->write(buffer.data(), used);
+        used = 0;
+    }
+
+    /**
+     * Vacía el buffer sin volcarlo.
+     **/
+    void clear() {
+        used = 0;
+    }
+
+    const char* data() const { return buffer.data(); }
+    size_t size() const { return used; }
+
+private:
+
+    static const size_t MAX_NUMBER_SIZE = 32;   ///< Carácteres de un número sin contar su precisión.
+
+    /**
+     * Se asegura de que quede sitio en el buffer, volcándolo o haciéndolo
+     * crecer.
+     *
+     * @param [in]  size    Carácteres necesarios.
+     **/
+    void reserve(size_t size) {
+        if (size <= buffer.size() - used)
+            return;
+
+        flush();
+        if (size > buffer.size() - used)
+            buffer.resize(std::max(2 * buffer.size(), used + size));
+    }
+
+    std::ostream* where;        ///< "Output stream" en el que se vuelca el buffer, nullptr si es en memoria.
+    std::vector<char> buffer;   ///< Carácteres pendientes de volcar.
+    size_t used;                ///< Carácteres usados del buffer.
+    int precision;              ///< Cifras significativas de los números reales.
+};
+
+/**
+ * Escribe las filas de un fichero repartiéndolas entre todos los hilos. Las
+ * filas se agrupan en partes, cada hilo escribe partes enteras en su propio
+ * buffer en memoria, y los buffers se vuelcan en orden en el "output stream",
+ * por lo que el resultado es el mismo que escribiendo las filas una a una.
+ * Para no guardar todo el fichero en memoria las partes se escriben por
+ * tandas de dos por hilo.
+ *
+ * @param [in,out]  where       "Output stream" en el que se escriben las filas.
+ * @param [in]      rows        Número de filas.
+ * @param [in]      format_row  Función que recibe un OutputBuffer y el índice
+ *                              de una fila y escribe la fila en él. Se llama
+ *                              desde varios hilos a la vez.
+ **/
+template <typename F>
+void parallelWriteRows(std::ostream& where, size_t rows, F format_row) {
+    const size_t CHUNK_ROWS = 1 << 14;
+
+    size_t chunks = (rows + CHUNK_ROWS - 1) / CHUNK_ROWS;
+    size_t batch = std::min<size_t>(2 * getThreadsAmount(), chunks);
+    int precision = where.precision();
+
+    std::vector<std::unique_ptr<OutputBuffer>> buffers;
+    for (size_t i = 0; i < batch; ++i) {
+        buffers.emplace_back(new OutputBuffer(precision));
+    }
+
+    for (size_t first = 0; first < chunks; first += batch) {
+        size_t amount = std::min(batch, chunks - first);
+
+        parallelFor(amount, [&](size_t i) {
+            OutputBuffer& buffer = *buffers[i];
+            size_t begin = (first + i) * CHUNK_ROWS;
+            size_t end = std::min(rows, begin + CHUNK_ROWS);
+
+            buffer.clear();
+            for (size_t row = begin; row < end; ++row) {
+                format_row(buffer, row);
+            }
+        });
+
+        for (size_t i = 0; i < amount; ++i) {
+            where.write(buffers[i]->data(), buffers[i]->size());
+        }
+    }
+}
+
+#endif /* OUTPUTBUFFER_H */
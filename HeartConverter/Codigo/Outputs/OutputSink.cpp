@@ -0,0 +1,134 @@
+/**
+ * @file OutputSink.cpp
+ *
+ * Clase abstracta que representa el destino de un fichero de salida. Es un
+ * "stream buffer", así que los ficheros se siguen escribiendo con el operador
+ * << sobre un std::ostream, y cada subclase decide cómo llegan los carácteres
+ * al disco. El área de escritura la proporciona la subclase y solo se vacía
+ * cuando se llena o al cerrar el fichero, nunca al hacer flush del stream.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#include "OutputSink.h"
+#include "BufferedSink.h"
+#include "MappedSink.h"
+#include "UringSink.h"
+#include "CompressedSink.h"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <climits>
+using namespace std;
+
+/**
+ * Crea el destino de un fichero de salida. Si se indica un formato de
+ * compresión los datos se comprimen antes de pasarlos al destino.
+ *
+ * @param [in]  type        Tipo de destino: "buffer", "mmap" o "uring".
+ * @param [in]  file_name   Nombre del fichero.
+ * @param [in]  compression Formato de compresión, vacio si no se comprime.
+ * @return Un puntero al destino, o nullptr si el tipo o el formato de
+ *         compresión no existen.
+ **/
+OutputSink* OutputSink::createSink(const string& type, const string& file_name, const string& compression) {
+    if (compression != "" && !CompressedSink::isSupported(compression))
+        return nullptr;
+
+    OutputSink* sink = nullptr;
+
+    if (type == "buffer") {
+        sink = new BufferedSink(file_name);
+    }
+    else if (type == "mmap") {
+        sink = new MappedSink(file_name);
+    }
+    else if (type == "uring") {
+        UringSink* uring = new UringSink(file_name);
+
+        //Los núcleos antiguos o los contenedores pueden no permitir io_uring
+        if (!uring->isAvailable()) {
+            cout << "io_uring isn't available, using buffer instead." << endl;
+            delete uring;
+            sink = new BufferedSink(file_name);
+        }
+        else {
+            sink = uring;
+        }
+    }
+
+    if (sink != nullptr && compression != "")
+        sink = new CompressedSink(sink, compression);
+
+    return sink;
+}
+
+/**
+ * Devuelve los tipos de destino que admite createSink.
+ *
+ * @return Vector con el nombre de cada tipo.
+ **/
+vector<string> OutputSink::getSinkTypes() {
+    return {"buffer", "mmap", "uring"};
+}
+
+/**
+ * Se llama cuando el área de escritura está llena. Entrega el área y escribe
+ * el carácter en la nueva.
+ *
+ * @param [in]  character   Carácter que no cabía en el área.
+ * @return El carácter, o eof si ha fallado la escritura.
+ **/
+OutputSink::int_type OutputSink::overflow(int_type character) {
+    if (!is_open || !flushArea()) {
+        is_open = false;
+        return traits_type::eof();
+    }
+
+    if (!traits_type::eq_int_type(character, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(character);
+        pbump(1);
+    }
+
+    return traits_type::not_eof(character);
+}
+
+/**
+ * Copia un bloque de carácteres en el área de escritura, entregándola cada
+ * vez que se llena.
+ *
+ * @param [in]  text    Carácteres a escribir.
+ * @param [in]  size    Número de carácteres.
+ * @return Número de carácteres escritos.
+ **/
+streamsize OutputSink::xsputn(const char* text, streamsize size) {
+    streamsize written = 0;
+
+    while (written < size) {
+        if (pptr() == epptr() && (!is_open || !flushArea())) {
+            is_open = false;
+            break;
+        }
+
+        //pbump solo admite un int
+        streamsize amount = min<streamsize>({size - written, epptr() - pptr(), INT_MAX});
+        memcpy(pptr(), text + written, amount);
+        pbump((int) amount);
+        written += amount;
+    }
+
+    return written;
+}
+
+/**
+ * Los datos se escriben al llenarse el área o al cerrar, así que hacer flush
+ * del stream no escribe nada.
+ *
+ * @return 0 si no ha habido errores, -1 en otro caso.
+ **/
+int OutputSink::sync() {
+    return is_open ? 0 : -1;
+}
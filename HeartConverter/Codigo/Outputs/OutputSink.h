@@ -0,0 +1,67 @@
+/**
+ * @file OutputSink.h
+ *
+ * Clase abstracta que representa el destino de un fichero de salida. Es un
+ * "stream buffer", así que los ficheros se siguen escribiendo con el operador
+ * << sobre un std::ostream, y cada subclase decide cómo llegan los carácteres
+ * al disco. El área de escritura la proporciona la subclase y solo se vacía
+ * cuando se llena o al cerrar el fichero, nunca al hacer flush del stream.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#ifndef OUTPUTSINK_H
+#define OUTPUTSINK_H
+
+#include <streambuf>
+#include <string>
+#include <vector>
+
+class OutputSink : public std::streambuf {
+public:
+
+    static OutputSink* createSink(const std::string&, const std::string&, const std::string& = "");
+    static std::vector<std::string> getSinkTypes();
+
+    /**
+     * Indica si el fichero se ha podido abrir y no ha fallado ninguna
+     * escritura.
+     **/
+    bool isOpen() const {
+        return is_open;
+    }
+
+    /**
+     * Escribe todo lo pendiente y cierra el fichero.
+     *
+     * @return true si todos los datos se han escrito.
+     **/
+    virtual bool close() = 0;
+
+    OutputSink(const OutputSink&) = delete;
+    OutputSink& operator=(const OutputSink&) = delete;
+    virtual ~OutputSink() {}
+
+protected:
+
+    OutputSink() : is_open(false) {}
+
+    int_type overflow(int_type) override;
+    std::streamsize xsputn(const char*, std::streamsize) override;
+    int sync() override;
+
+    /**
+     * Entrega el área de escritura llena, [pbase(), pptr()), y prepara una
+     * nueva con setp().
+     *
+     * @return false si no se han podido escribir los datos.
+     **/
+    virtual bool flushArea() = 0;
+
+    bool is_open;   ///< El fichero está abierto y no ha habido errores.
+};
+
+#endif /* OUTPUTSINK_H */
@@ -0,0 +1,284 @@
+/**
+ * @file UringSink.cpp
+ *
+ * Destino de un fichero de salida que escribe de forma asíncrona con
+ * io_uring. Los carácteres se acumulan en varios buffers que se usan por
+ * turnos: cuando uno se llena se pide al núcleo que lo escriba y se sigue
+ * escribiendo en el siguiente, de forma que el formateo de los ficheros y la
+ * escritura en el disco se solapan. Un buffer no se reutiliza hasta que el
+ * núcleo ha terminado de escribirlo. Se usan directamente las llamadas al
+ * sistema, sin liburing.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#include "UringSink.h"
+#include <string>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define HAS_IO_URING
+#endif
+
+using namespace std;
+
+/**
+ * Constructor. Prepara io_uring y, si está disponible, crea el fichero o lo
+ * vacía si ya existía. Si no se puede crear isOpen() devolverá false.
+ *
+ * @param [in]  file_name   Nombre del fichero.
+ **/
+UringSink::UringSink(const string& file_name) : buffers(BUFFERS) {
+    descriptor = -1;
+    ring_descriptor = -1;
+    sq_ring = cq_ring = sqes = cqes = nullptr;
+    sq_ring_size = cq_ring_size = sqes_size = 0;
+    current = 0;
+    offset = 0;
+
+    if (!setupRing())
+        return;
+
+    descriptor = open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    is_open = (descriptor >= 0);
+
+    for (auto& buffer : buffers) {
+        buffer.data.resize(BUFFER_SIZE);
+    }
+    useBuffer(0);
+}
+
+/**
+ * Crea la instancia de io_uring y proyecta en memoria sus colas.
+ *
+ * @return false si el núcleo no permite usar io_uring.
+ **/
+bool UringSink::setupRing() {
+#ifdef HAS_IO_URING
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    int ring = syscall(__NR_io_uring_setup, BUFFERS, &params);
+    if (ring < 0)
+        return false;
+
+    sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    //Los núcleos recientes proyectan las dos colas a la vez
+    bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap)
+        sq_ring_size = cq_ring_size = max(sq_ring_size, cq_ring_size);
+
+    sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQ_RING);
+    cq_ring = single_mmap ? sq_ring :
+        mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_CQ_RING);
+    sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    sqes = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQES);
+
+    if (sq_ring == MAP_FAILED || cq_ring == MAP_FAILED || sqes == MAP_FAILED) {
+        if (sq_ring != MAP_FAILED)
+            munmap(sq_ring, sq_ring_size);
+        if (!single_mmap && cq_ring != MAP_FAILED)
+            munmap(cq_ring, cq_ring_size);
+        if (sqes != MAP_FAILED)
+            munmap(sqes, sqes_size);
+        sq_ring = cq_ring = sqes = nullptr;
+        ::close(ring);
+        return false;
+    }
+
+    char* sq = static_cast<char*>(sq_ring);
+    char* cq = static_cast<char*>(cq_ring);
+    sq_tail = reinterpret_cast<unsigned int*>(sq + params.sq_off.tail);
+    sq_mask = reinterpret_cast<unsigned int*>(sq + params.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned int*>(sq + params.sq_off.array);
+    cq_head = reinterpret_cast<unsigned int*>(cq + params.cq_off.head);
+    cq_tail = reinterpret_cast<unsigned int*>(cq + params.cq_off.tail);
+    cq_mask = reinterpret_cast<unsigned int*>(cq + params.cq_off.ring_mask);
+    cqes = cq + params.cq_off.cqes;
+
+    ring_descriptor = ring;
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Coloca el área de escritura sobre un buffer.
+ *
+ * @param [in]  index   Índice del buffer.
+ **/
+void UringSink::useBuffer(unsigned int index) {
+    char* data = buffers[index].data.data();
+    current = index;
+    setp(data, data + buffers[index].data.size());
+}
+
+/**
+ * Pide al núcleo que escriba un buffer en la posición actual del fichero.
+ * Como nunca hay más peticiones pendientes que buffers, siempre hay sitio en
+ * la cola de envíos.
+ *
+ * @param [in]  index   Índice del buffer.
+ * @param [in]  size    Carácteres a escribir.
+ **/
+void UringSink::submit(unsigned int index, size_t size) {
+#ifdef HAS_IO_URING
+    UringBuffer& buffer = buffers[index];
+    buffer.size = size;
+    buffer.offset = offset;
+    buffer.busy = true;
+    offset += size;
+
+    unsigned int tail = *sq_tail;
+    unsigned int slot = tail & *sq_mask;
+    io_uring_sqe* sqe = static_cast<io_uring_sqe*>(sqes) + slot;
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_WRITE;
+    sqe->fd = descriptor;
+    sqe->addr = reinterpret_cast<unsigned long>(buffer.data.data());
+    sqe->len = size;
+    sqe->off = buffer.offset;
+    sqe->user_data = index;
+
+    sq_array[slot] = slot;
+    __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    int submitted;
+    do {
+        submitted = syscall(__NR_io_uring_enter, ring_descriptor, 1, 0, 0, nullptr, 0);
+    } while (submitted < 0 && errno == EINTR);
+
+    //El núcleo no ha aceptado la petición, así que no habrá resultado
+    if (submitted < 0) {
+        is_open = false;
+        buffer.busy = false;
+    }
+#endif
+}
+
+/**
+ * Recoge los resultados de las escrituras que han terminado. Si el núcleo
+ * ha escrito solo una parte de un buffer, o no ha podido escribirlo, el
+ * resto se escribe con pwrite; si también falla se marca el error.
+ **/
+void UringSink::reapCompletions() {
+#ifdef HAS_IO_URING
+    unsigned int head = *cq_head;
+    unsigned int tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+
+    for (; head != tail; ++head) {
+        io_uring_cqe* cqe = static_cast<io_uring_cqe*>(cqes) + (head & *cq_mask);
+        UringBuffer& buffer = buffers[cqe->user_data];
+        size_t written = (cqe->res < 0) ? 0 : cqe->res;
+
+        while (written < buffer.size) {
+            ssize_t result = pwrite(descriptor, buffer.data.data() + written, buffer.size - written, buffer.offset + written);
+            if (result < 0 && errno == EINTR)
+                continue;
+            if (result <= 0) {
+                is_open = false;
+                break;
+            }
+            written += result;
+        }
+
+        buffer.busy = false;
+    }
+
+    __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+#endif
+}
+
+/**
+ * Espera a que el núcleo termine de escribir un buffer.
+ *
+ * @param [in]  index   Índice del buffer.
+ **/
+void UringSink::waitBuffer(unsigned int index) {
+#ifdef HAS_IO_URING
+    reapCompletions();
+
+    while (buffers[index].busy) {
+        int result = syscall(__NR_io_uring_enter, ring_descriptor, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+        if (result < 0 && errno != EINTR) {
+            //Sin resultados no se puede saber si el buffer está libre
+            is_open = false;
+            buffers[index].busy = false;
+            break;
+        }
+        reapCompletions();
+    }
+#endif
+}
+
+/**
+ * Envía el buffer actual al núcleo y continúa en el siguiente, esperando a
+ * que esté libre.
+ *
+ * @return false si ha fallado alguna escritura.
+ **/
+bool UringSink::flushArea() {
+    size_t size = pptr() - pbase();
+    unsigned int next = (current + 1) % BUFFERS;
+
+    if (size > 0)
+        submit(current, size);
+
+    waitBuffer(next);
+    useBuffer(next);
+    return is_open;
+}
+
+/**
+ * Envía lo que quede en el buffer actual, espera a que terminen todas las
+ * escrituras y cierra el fichero.
+ *
+ * @return true si todos los datos se han escrito.
+ **/
+bool UringSink::close() {
+    if (descriptor < 0)
+        return false;
+
+    if (is_open && pptr() > pbase())
+        submit(current, pptr() - pbase());
+
+    for (unsigned int i = 0; i < BUFFERS; ++i) {
+        waitBuffer(i);
+    }
+
+    if (::close(descriptor) != 0)
+        is_open = false;
+
+    descriptor = -1;
+    setp(nullptr, nullptr);
+    return is_open;
+}
+
+/**
+ * Destructor. Cierra el fichero si no se había cerrado y libera io_uring.
+ **/
+UringSink::~UringSink() {
+    close();
+
+    if (ring_descriptor >= 0) {
+        munmap(sqes, sqes_size);
+        if (cq_ring != sq_ring)
+            munmap(cq_ring, cq_ring_size);
+        munmap(sq_ring, sq_ring_size);
+        ::close(ring_descriptor);
+    }
+}
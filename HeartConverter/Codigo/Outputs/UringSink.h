@@ -0,0 +1,89 @@
+/**
+ * @file UringSink.h
+ *
+ * Destino de un fichero de salida que escribe de forma asíncrona con
+ * io_uring. Los carácteres se acumulan en varios buffers que se usan por
+ * turnos: cuando uno se llena se pide al núcleo que lo escriba y se sigue
+ * escribiendo en el siguiente, de forma que el formateo de los ficheros y la
+ * escritura en el disco se solapan. Un buffer no se reutiliza hasta que el
+ * núcleo ha terminado de escribirlo.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#ifndef URINGSINK_H
+#define URINGSINK_H
+
+#include <string>
+#include <vector>
+#include "OutputSink.h"
+
+class UringSink : public OutputSink {
+public:
+
+    static const unsigned int BUFFERS = 4;      ///< Buffers que se pueden estar escribiendo a la vez.
+    static const size_t BUFFER_SIZE = 1 << 20;  ///< Tamaño de cada buffer, 1 MiB.
+
+    UringSink(const std::string&);
+
+    /**
+     * Indica si el núcleo permite usar io_uring. Si no, el fichero no se
+     * llega a abrir.
+     **/
+    bool isAvailable() const {
+        return ring_descriptor >= 0;
+    }
+
+    bool close() override;
+
+    ~UringSink();
+
+protected:
+
+    bool flushArea() override;
+
+private:
+
+    /**
+     * Estado de cada buffer.
+     **/
+    typedef struct UringBuffer {
+        std::vector<char> data;     ///< Carácteres del buffer.
+        size_t size = 0;            ///< Carácteres que se están escribiendo.
+        size_t offset = 0;          ///< Posición del fichero en la que se escriben.
+        bool busy = false;          ///< El núcleo no ha terminado de escribirlo.
+    } UringBuffer;
+
+    bool setupRing();
+    void submit(unsigned int, size_t);
+    void waitBuffer(unsigned int);
+    void reapCompletions();
+    void useBuffer(unsigned int);
+
+    int descriptor;                 ///< Descriptor del fichero, -1 si está cerrado.
+    int ring_descriptor;            ///< Descriptor de io_uring, -1 si no está disponible.
+
+    void* sq_ring;                  ///< Proyección de la cola de envíos.
+    size_t sq_ring_size;            ///< Tamaño de la proyección de la cola de envíos.
+    void* cq_ring;                  ///< Proyección de la cola de resultados, puede ser la misma.
+    size_t cq_ring_size;            ///< Tamaño de la proyección de la cola de resultados.
+    void* sqes;                     ///< Array de peticiones.
+    size_t sqes_size;               ///< Tamaño del array de peticiones.
+
+    unsigned int* sq_tail;          ///< Final de la cola de envíos.
+    unsigned int* sq_mask;          ///< Máscara de los índices de la cola de envíos.
+    unsigned int* sq_array;         ///< Índices de las peticiones de la cola de envíos.
+    unsigned int* cq_head;          ///< Comienzo de la cola de resultados.
+    unsigned int* cq_tail;          ///< Final de la cola de resultados.
+    unsigned int* cq_mask;          ///< Máscara de los índices de la cola de resultados.
+    void* cqes;                     ///< Array de resultados.
+
+    std::vector<UringBuffer> buffers;   ///< Buffers que se usan por turnos.
+    unsigned int current;           ///< Buffer del área de escritura.
+    size_t offset;                  ///< Posición del fichero en la que se escribirá el buffer actual.
+};
+
+#endif /* URINGSINK_H */
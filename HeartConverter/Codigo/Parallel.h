@@ -0,0 +1,69 @@
+/**
+ * @file Parallel.h
+ *
+ * Funciones de ayuda para repartir tareas independientes entre todos los
+ * núcleos disponibles.
+ *
+ * @author  Víctor Guillermo Andrés Escudero
+ * @date    17/10/2026
+ * @version 1.0
+ *
+ **/
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+
+/**
+ * Devuelve el número de hilos que se usarán para las tareas en paralelo.
+ **/
+inline unsigned int getThreadsAmount() {
+    unsigned int threads_amount = std::thread::hardware_concurrency();
+    return (threads_amount == 0) ? 1 : threads_amount;
+}
+
+/**
+ * Ejecuta task(i) para cada i entre 0 y tasks - 1. Las tareas se reparten
+ * dinámicamente entre los hilos, el hilo que llama a la función también
+ * trabaja, y la función no termina hasta que todas las tareas han acabado.
+ * Las tareas no deben depender unas de otras.
+ *
+ * @param [in]  tasks   Número de tareas.
+ * @param [in]  task    Función que recibe el índice de la tarea.
+ **/
+template <typename F>
+void parallelFor(size_t tasks, F task) {
+    size_t threads_amount = std::min<size_t>(getThreadsAmount(), tasks);
+
+    if (threads_amount <= 1) {
+        for (size_t i = 0; i < tasks; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next_task(0);
+    auto worker = [&]() {
+        size_t i;
+        while ((i = next_task++) < tasks) {
+            task(i);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threads_amount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+#endif /* PARALLEL_H */
+
@@ -17,8 +17,15 @@
 #include <vtkCell.h>
 #include <vtkType.h>
 #include <vtkCellType.h>
+#include <vtkCellArray.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkPolyData.h>
+#include <vtkVersionMacros.h>
 
 #include "Datasets/DatasetAbstract.h"
+#include "Datasets/DatasetContext.h"
+#include "Inputs/VtkLegacyReader.h"
+#include "Inputs/VtkXmlReader.h"
 #include "VtkParser.h"
 
 #include "vector"
@@ -26,38 +33,93 @@
 #include <iostream>
 using namespace std;
 
+static const size_t CELL_RUN_VALUES = 1 << 16;  ///< Índices de cada tramo de elementos que se añade de una vez.
+
 /**
  * Constructor. Lee el fichero de entrada y crea un objeto con toda la
- * información disponible.
+ * información disponible. Los ficheros "legacy" de tipo POLYDATA o
+ * UNSTRUCTURED_GRID se leen con VtkLegacyReader y los XML de tipo
+ * UnstructuredGrid o PolyData con VtkXmlReader al llamar a createDatasets(),
+ * el resto se leen con el lector genérico de VTK. Todos los conj. de datos
+ * se crean en el contexto indicado, que es su dueño.
  * 
  * @param [in]  file_name   Nombre del fichero de entrada.
+ * @param [in]  context     Contexto de la conversión, debe de vivir más que
+ *                          el parser.
  **/
-VtkParser::VtkParser(const char* file_name) {
+VtkParser::VtkParser(const char* file_name, DatasetContext& context) : context(context) {
+    
+    reader.reset(new VtkLegacyReader(file_name, context));
+    if (reader->isSupported()) {
+        return;
+    }
     
-    auto reader = vtkSmartPointer<vtkDataSetReader>::New();
-    reader->SetFileName(file_name);
-    reader->Update();
+    reader.reset(new VtkXmlReader(file_name, context));
+    if (reader->isSupported()) {
+        return;
+    }
+    reader.reset();
     
-    vtk_data = reader->GetOutput();
+    auto vtk_reader = vtkSmartPointer<vtkDataSetReader>::New();
+    vtk_reader->SetFileName(file_name);
+    vtk_reader->Update();
+    
+    vtk_data = vtk_reader->GetOutput();
 }
 
 
 /**
  * Función de ayuda. Llama a otras funciones para obtener los datos del
- * conjunto de datos.
+ * conjunto de datos. Los puntos y elementos se obtienen siempre, pero de los
+ * arrays de atributos solo se obtienen los indicados. El resto se crean bajo
+ * demanda la primera vez que se buscan con DatasetContext::getDataset.
+ * Si la malla es homogénea los puntos y elementos pueden pasar a guardarse en
+ * conj. de datos de tamaño de fila fijo.
+ * 
+ * @param [in]  arrays      Nombres de los arrays de atributos que se necesitan.
+ * @param [in]  fixed_arity Indica si se pueden usar conj. de datos de tamaño
+ *                          de fila fijo, es decir, si nadie va a añadir filas
+ *                          de otro tamaño a los puntos o elementos.
  **/
-void VtkParser::createDatasets() {
+void VtkParser::createDatasets(const vector<string>& arrays, bool fixed_arity) {
 
-    //GetPoints
-    createPoints();
-    
-    //GetElements
-    createElements();
+    //El lector propio rellena los conj. de datos directamente
+    if (reader) {
+        reader->read(arrays);
+        context.setLoader([this](const string& name) {
+            return reader->loadArray(name);
+        });
+    }
+    else {
+        //GetPoints
+        createPoints();
+        
+        //GetElements
+        createElements();
+        
+        //GetArrays
+        for (const auto& name : arrays) {
+            createAttribute(name);
+        }
+        context.setLoader([this](const string& name) {
+            return createAttribute(name);
+        });
+    }
     
-    //GetArrays
-    createAttributes(vtkDataSet::AttributeTypes::POINT);
-    createAttributes(vtkDataSet::AttributeTypes::CELL);
-    createAttributes(vtkDataSet::AttributeTypes::FIELD);
+    if (fixed_arity) {
+        context.fixArity("points");
+        context.fixArity("elements");
+    }
+}
+
+
+/**
+ * Destructor. Definido aquí para que AbstractReader este completo al
+ * destruir el unique_ptr. Deshabilita la carga bajo demanda del contexto, que
+ * depende de este objeto. Los conj. de datos siguen siendo del contexto.
+ **/
+VtkParser::~VtkParser() {
+    context.setLoader(nullptr);
 }
 
 
@@ -69,7 +131,7 @@ void VtkParser::createPoints() {
     
     unsigned int size = vtk_data->GetNumberOfPoints();
     
-    DatasetAbstract* points = DatasetAbstract::FactoryDataset("double", "points", size);
+    DatasetAbstract* points = context.createDataset("double", "points", size);
     
     vtkIdType id[1];
     double coords[3];
@@ -86,62 +148,149 @@ void VtkParser::createPoints() {
 
 /**
  * Obtiene para cada elemento que tipo es (linea/triangulo/prisma etc) y los
- * indices de los puntos que los componen.
+ * indices de los puntos que los componen. En UnstructuredGrid y PolyData se
+ * recorre directamente la conectividad de sus vtkCellArray, el resto de
+ * conj. de datos se recorren reutilizando una única lista de índices. En
+ * ningún caso se crea un vtkCell por elemento.
  **/
 void VtkParser::createElements() {
     
     unsigned int size = vtk_data->GetNumberOfCells();
     
-    DatasetAbstract* elements = DatasetAbstract::FactoryDataset("unsigned int", "elements", size);
-    DatasetAbstract* primitives = DatasetAbstract::FactoryDataset("unsigned short", "primitives", size);
+    DatasetAbstract* elements = context.createDataset("unsigned int", "elements", size);
+    DatasetAbstract* primitives = context.createDataset("unsigned short", "primitives", size);
     
-    vtkIdType point_id[1], cell_id[1];
+    CellRun run;
+    run.points_amount = 0;
+    run.elements = elements;
+    run.primitives = primitives;
+    vtkIdType cell_id = 0;
     
-    for (unsigned int i = 0; i < size; ++i) {
-        cell_id[0] = i;
-        auto cell = vtk_data->GetCell(cell_id[0]);
-        
-        double primitive[1];
-        primitive[0] = cell->GetCellType();
-        primitives->addData(primitive, 1);
-        
-        auto index_list = cell->GetPointIds();
-        vector<double> element_ids;
+    auto grid = vtkUnstructuredGrid::SafeDownCast(vtk_data);
+    auto poly_data = vtkPolyData::SafeDownCast(vtk_data);
+    
+    if (grid != nullptr) {
+        addCellArray(grid->GetCells(), cell_id, run);
+    }
+    else if (poly_data != nullptr) {
+        //Mismo orden en el que VTK numera los elementos de PolyData
+        addCellArray(poly_data->GetVerts(), cell_id, run);
+        addCellArray(poly_data->GetLines(), cell_id, run);
+        addCellArray(poly_data->GetPolys(), cell_id, run);
+        addCellArray(poly_data->GetStrips(), cell_id, run);
+    }
+    else {
+        auto index_list = vtkSmartPointer<vtkIdList>::New();
         
-        for (unsigned int j = 0; j < index_list->GetNumberOfIds(); ++j) {
-            point_id[0] = j; 
-            element_ids.push_back(index_list->GetId(point_id[0]));
+        for (cell_id = 0; cell_id < size; ++cell_id) {
+            vtk_data->GetCellPoints(cell_id, index_list);
+            addCell(run, vtk_data->GetCellType(cell_id), index_list->GetNumberOfIds(), index_list->GetPointer(0));
         }
-        
-        elements->addData(element_ids);         
     }
     
+    flushCells(run);
+}
+
+/**
+ * Añade los elementos de un vtkCellArray recorriendo su conectividad. El tipo
+ * de cada elemento se obtiene del conj. de datos, que no necesita crear un
+ * vtkCell para ello.
+ * 
+ * @param [in]      cells       Conectividad de los elementos.
+ * @param [in,out]  cell_id     Índice del primer elemento del array. Al
+ *                              terminar apunta al siguiente elemento.
+ * @param [in,out]  run         Tramo de elementos pendientes de añadir.
+ **/
+void VtkParser::addCellArray(vtkCellArray* cells, vtkIdType& cell_id, CellRun& run) {
+    
+    if (cells == nullptr)
+        return;
+    
+#if VTK_MAJOR_VERSION >= 9
+    const vtkIdType* point_ids;
+#else
+    vtkIdType* point_ids;
+#endif
+    vtkIdType points_amount;
+    
+    cells->InitTraversal();
+    while (cells->GetNextCell(points_amount, point_ids)) {
+        addCell(run, vtk_data->GetCellType(cell_id++), points_amount, point_ids);
+    }
+}
+
+/**
+ * Añade un elemento al tramo, convirtiendo sus índices y su tipo a los tipos
+ * enteros de los conj. de datos. Si el elemento no tiene el mismo número de
+ * puntos que los del tramo, o el tramo está lleno, antes se añade el tramo.
+ * 
+ * @param [in,out]  run             Tramo de elementos pendientes de añadir.
+ * @param [in]      type            Tipo del elemento.
+ * @param [in]      points_amount   Número de puntos del elemento.
+ * @param [in]      point_ids       Índices de los puntos del elemento.
+ **/
+void VtkParser::addCell(CellRun& run, int type, vtkIdType points_amount, const vtkIdType* point_ids) {
+    
+    if (points_amount != run.points_amount || run.ids.size() + points_amount > CELL_RUN_VALUES) {
+        flushCells(run);
+        run.points_amount = points_amount;
+    }
+    
+    run.types.push_back(static_cast<unsigned short>(type));
+    run.ids.insert(run.ids.end(), point_ids, point_ids + points_amount);
 }
 
 /**
- * Obtiene los arrays que contienen los atributos del conjuto de datos
- * asociados con los puntos, elementos o del propio conj. de datos. También los
- * almacena (con el nombre que se le ha dado en el fichero).
+ * Añade de una vez los elementos del tramo a los conj. de datos y lo vacía.
  * 
- * @param [in]  type    Entero que identifica los atributos del tipo de dato que
- *                      se quiere obtener. De acuerdo al enum disponible en la
- *                      clase vtkDataObject de VTK.
+ * @param [in,out]  run     Tramo de elementos pendientes de añadir.
  **/
-void VtkParser::createAttributes(int type) {
+void VtkParser::flushCells(CellRun& run) {
     
-    vtkSmartPointer<vtkFieldData> data_attribute = vtk_data->GetAttributesAsFieldData(type);
+    if (run.types.empty())
+        return;
     
-    for (unsigned int i = 0; i < data_attribute->GetNumberOfArrays(); ++i){
-        vtkSmartPointer<vtkDataArray> data_array = data_attribute->GetArray(i);
-        createAttributeFromArray (data_array);
+    run.elements->addRawData(run.ids.data(), sizeof(unsigned int), run.types.size(), run.points_amount);
+    run.primitives->addRawData(run.types.data(), sizeof(unsigned short), run.types.size(), 1);
+    
+    run.ids.clear();
+    run.types.clear();
+}
+
+/**
+ * Busca un array de atributos del conjuto de datos, asociado con los puntos,
+ * elementos o del propio conj. de datos, y lo almacena con el nombre que se le
+ * ha dado en el fichero.
+ * 
+ * @param [in]  name    Nombre del array.
+ * @return true si el array existe y se ha almacenado.
+ **/
+bool VtkParser::createAttribute(const string& name) {
+    
+    int types[] = {vtkDataSet::AttributeTypes::POINT,
+                   vtkDataSet::AttributeTypes::CELL,
+                   vtkDataSet::AttributeTypes::FIELD};
+    
+    for (auto type : types) {
+        vtkSmartPointer<vtkFieldData> data_attribute = vtk_data->GetAttributesAsFieldData(type);
+        if (data_attribute == nullptr)
+            continue;
+        
+        vtkSmartPointer<vtkDataArray> data_array = data_attribute->GetArray(name.c_str());
+        if (data_array != nullptr) {
+            createAttributeFromArray(data_array);
+            return true;
+        }
     }
     
+    return false;
 }
 
 /**
  * Almacena un array con información sobre el conj. de datos. Extrae del array
  * su nombre y tipo de datos (int, float, etc) para almacenarlos de forma
- * eficiente.
+ * eficiente. Si los valores del array son contiguos se copian directamente
+ * en su tipo nativo, si no se copian tupla a tupla.
  * 
  * @param [in]  array   Puntero a un array de vtk que se quiere almacenar.
  **/
@@ -153,16 +302,16 @@ void VtkParser::createAttributeFromArray(vtkSmartPointer<vtkDataArray> array){
     vtkIdType tuples_num = array->GetNumberOfTuples();
     int tuples_size = array->GetNumberOfComponents();
     
-    DatasetAbstract* array_dataset = DatasetAbstract::FactoryDataset(data_type, array_name, tuples_num);
+    DatasetAbstract* array_dataset = context.createDataset(data_type, array_name, tuples_num);
+    if (array_dataset == nullptr)
+        return;
+    
+    if (tuples_num > 0 && array->HasStandardMemoryLayout() &&
+        array_dataset->addRawData(array->GetVoidPointer(0), array->GetDataTypeSize(), tuples_num, tuples_size))
+        return;
     
     for (vtkIdType tuple_id = 0; tuple_id < tuples_num; ++tuple_id) {
-        double* tuples_data = array->GetTuple(tuple_id);
-        
-        vector<double> tuple_aux;
-        for (int j = 0; j < tuples_size; ++j){
-            tuple_aux.push_back(tuples_data[j]);
-        }
-        array_dataset->addData(tuple_aux);
+        array_dataset->addData(array->GetTuple(tuple_id), tuples_size);
     }
 }
 
@@ -17,20 +17,46 @@
 #include <vtkSmartPointer.h>
 #include <vtkDataSet.h>
 #include <vtkDataArray.h>
+#include <vtkCellArray.h>
 #include <memory>
+#include <vector>
+
+class AbstractReader;
+class DatasetAbstract;
+class DatasetContext;
 
 class VtkParser {
 public:
     vtkSmartPointer<vtkDataSet> vtk_data; ///< Puntero al conjunto de datos.
     
-    VtkParser(const char*);
+    VtkParser(const char*, DatasetContext&);
+    
+    void createDatasets(const std::vector<std::string>&, bool);
     
-    void createDatasets();
+    ~VtkParser();
     
 private:    
+    DatasetContext& context; ///< Contexto en el que se crean los conj. de datos.
+    std::unique_ptr<AbstractReader> reader; ///< Lector propio (VTK "legacy" o XML), si lo hay.
+    
+    /**
+     * Tramo de elementos seguidos con el mismo número de puntos, que se añaden
+     * de una vez a los conj. de datos.
+     **/
+    typedef struct CellRun {
+        std::vector<unsigned int> ids;      ///< Índices de los puntos de los elementos.
+        std::vector<unsigned short> types;  ///< Tipo de cada elemento.
+        vtkIdType points_amount;            ///< Número de puntos de cada elemento.
+        DatasetAbstract* elements;          ///< Conj. de datos con los índices de los puntos.
+        DatasetAbstract* primitives;        ///< Conj. de datos con el tipo de cada elemento.
+    } CellRun;
+
     void createPoints();
     void createElements();
-    void createAttributes(int);
+    void addCellArray(vtkCellArray*, vtkIdType&, CellRun&);
+    static void addCell(CellRun&, int, vtkIdType, const vtkIdType*);
+    static void flushCells(CellRun&);
+    bool createAttribute(const std::string&);
     void createAttributeFromArray (vtkSmartPointer<vtkDataArray>);
     
     static std::string vtkTypeToNative (int);
@@ -11,15 +11,24 @@
  **/
 
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <algorithm>
+#include <memory>
 #include "VtkParser.h"
+#include "Datasets/DatasetContext.h"
+#include "Datasets/DatasetSnapshot.h"
+#include "Datasets/PointDeduplicator.h"
 #include "Outputs/AbstractFile.h"
+#include "Outputs/OutputSink.h"
+#include "Outputs/CompressedSink.h"
 #include "Outputs/CarpPoints.h"
 #include "Outputs//CarpPurkinje.h"
 #include "Outputs/CarpElements.h"
+#include "Outputs/CarpBinaryPoints.h"
+#include "Outputs/CarpBinaryElements.h"
 using namespace std;
 
 /**
@@ -29,6 +38,11 @@ struct Parameters{
     string input_file;  ///< Ruta del archivo de entrada que sera convertido.
     string output_file; ///< Ruta del archivo de salida que creará el programa.
     string mode;        ///< El tipo de archivos que se obtendran.
+    string cache_dir;   ///< Directorio de la caché de conj. de datos, vacio si no se usa.
+    string sink = "buffer"; ///< Forma de escribir los ficheros de salida: buffer, mmap o uring.
+    string compression; ///< Formato de compresión de los ficheros de salida, vacio si no se comprimen.
+    bool merge_chains = false; ///< Indica si se unen los cables de Purkinje sin bifurcaciones.
+    bool remove_duplicates = false; ///< Indica si se eliminan los puntos repetidos de la malla del corazón.
 };
 
 Parameters printHelpMessage();
@@ -71,44 +85,115 @@ int main(int argc, char* argv[]) {
 
 /**
  * Inicializa las clases necesarias para ejecutar el programa. Y comprueba
- * que los parámetros suministrados sean válidos.
+ * que los parámetros suministrados sean válidos. Todos los conj. de datos de
+ * la conversión pertenecen a un contexto propio que los libera al terminar.
+ * Si se ha indicado un directorio de caché los conj. de datos se obtienen de
+ * ella cuando el fichero de entrada ya se ha convertido antes, y si no se
+ * guardan en ella tras leerlo. Los puntos repetidos de la malla del corazón
+ * se eliminan después, así que la caché no depende de ello.
  * 
  * @param [in]  p Structura que contiene la información necesaria para ejecutar el programa.
  **/
 void runProgram(Parameters p) {
+    DatasetContext context;
     vector<AbstractFile*> ficheros;
     
+    if (p.compression != "" && !CompressedSink::isSupported(p.compression)) {
+        cout << "This type of compression is not recognized or isn't available." << endl;
+        cout << "Try GZIP or ZSTD." << endl;
+        return;
+    }
+    
     if (p.mode == "h" || p.mode == "heart" ||
+        p.mode == "hb" || p.mode == "heart-binary" ||
         p.mode == "p" || p.mode == "purkinje") {
         
-        VtkParser parser(p.input_file.c_str());
-        parser.createDatasets();
+        bool is_binary = (p.mode == "hb" || p.mode == "heart-binary");
+        bool is_heart = (p.mode == "h" || p.mode == "heart" || is_binary);
         
-        if (p.mode == "h" || p.mode == "heart"){
-            ficheros.push_back(new CarpElements(p.output_file));
-            ficheros.push_back(new CarpPoints(p.output_file));
+        //Solo se leen los arrays que necesitan los ficheros de salida
+        vector<string> arrays;
+        if (is_binary) {
+            arrays = CarpBinaryElements::getRequiredArrays();
+            vector<string> points_arrays = CarpBinaryPoints::getRequiredArrays();
+            arrays.insert(arrays.end(), points_arrays.begin(), points_arrays.end());
         }
-        else if (p.mode == "p" || p.mode == "purkinje"){
-            ficheros.push_back(new CarpPurkinje(p.output_file));
+        else if (is_heart) {
+            arrays = CarpElements::getRequiredArrays();
+            vector<string> points_arrays = CarpPoints::getRequiredArrays();
+            arrays.insert(arrays.end(), points_arrays.begin(), points_arrays.end());
+        }
+        else {
+            arrays = CarpPurkinje::getRequiredArrays();
+        }
+        
+        unique_ptr<VtkParser> parser;
+        unique_ptr<DatasetSnapshot> snapshot;
+        if (p.cache_dir != "") {
+            snapshot.reset(new DatasetSnapshot(p.cache_dir, p.input_file));
+        }
+        
+        //CarpPurkinje divide cables y añade puntos, por lo que necesita
+        //filas de tamaño variable
+        if (!snapshot || !snapshot->load(arrays, is_heart, context)) {
+            parser.reset(new VtkParser(p.input_file.c_str(), context));
+            parser->createDatasets(arrays, is_heart);
+            
+            if (snapshot) {
+                snapshot->save(arrays, context);
+            }
+        }
+        
+        if (is_heart && p.remove_duplicates) {
+            PointDeduplicator(context).removeDuplicates();
+        }
+        
+        if (is_binary){
+            ficheros.push_back(new CarpBinaryElements(p.output_file, context));
+            ficheros.push_back(new CarpBinaryPoints(p.output_file, context));
+        }
+        else if (is_heart){
+            ficheros.push_back(new CarpElements(p.output_file, context));
+            ficheros.push_back(new CarpPoints(p.output_file, context));
+        }
+        else {
+            ficheros.push_back(new CarpPurkinje(p.output_file, context, p.merge_chains));
         }
     }
     else {
                 
         cout << "This type of output file is not recognized." << endl;
         cout << "Try HEART or H for .pts and .elem files." << endl;
+        cout << "Try HEART-BINARY or HB for .bpts and .belem files." << endl;
         cout << "Try PURKINJE or P for .pkje file" << endl;
     }
     
     //Run the program
     for (unsigned int i = 0; i < ficheros.size(); ++i){
         string file_name;
-        ofstream file;
+        unique_ptr<OutputSink> sink;
         
-        file_name = ficheros[i]->getName() + ficheros[i]->getExtension();
+        file_name = ficheros[i]->getName() + ficheros[i]->getExtension()
+                  + CompressedSink::getExtension(p.compression);
         
-        file.open(file_name);
-        file << *ficheros[i];
-        file.close();
+        sink.reset(OutputSink::createSink(p.sink, file_name, p.compression));
+        if (!sink) {
+            cout << "This type of output sink is not recognized." << endl;
+            cout << "Try BUFFER, MMAP or URING." << endl;
+        }
+        else if (!sink->isOpen()) {
+            cout << "The file " << file_name << " couldn't be created." << endl;
+        }
+        else {
+            ostream file(sink.get());
+            file << *ficheros[i];
+            
+            if (!sink->close()) {
+                cout << "The file " << file_name << " couldn't be written." << endl;
+            }
+        }
+        
+        delete ficheros[i];
     }
     
 }
@@ -133,7 +218,7 @@ Parameters printHelpMessage() {
     cout << endl;
     
     string mode;
-    cout << "Convert the file into CARP's HEART or PURKINJE files? (HEART/PURKINJE)" << endl;
+    cout << "Convert the file into CARP's HEART or PURKINJE files? (HEART/HEART-BINARY/PURKINJE)" << endl;
     //cin >> mode;
     getline(cin, parameters.mode);
     cout << endl;
@@ -144,8 +229,12 @@ Parameters printHelpMessage() {
 
 /**
  * Parsea los parámetros suministrados por linea de comandos. El programa busca
- * las siguientes "flags" -o (-output), -i (-input), -m (-mode) y toma el
- * siguiente parámetro como el valor suministrado por el usuario.
+ * las siguientes "flags" -o (-output), -z (-compress), -i (-input), -m (-mode),
+ * -c (-cache), -s (-sink) y toma el siguiente parámetro como el valor
+ * suministrado por el usuario. Las
+ * "flags" -j (-join) y -d (-dedup) no tienen valor e indican que se unan los
+ * cables de Purkinje sin bifurcaciones entre ellos y que se eliminen los
+ * puntos repetidos de la malla del corazón.
  * 
  * @param [in]  argc    Número de arg. suministrados por linea de comandos.
  * @param [in]  argv    Vector de arg. suministrados por la linea de comandos.
@@ -154,14 +243,28 @@ Parameters printHelpMessage() {
 Parameters parseParameters(int argc, char* argv[]) {
     char* p;
     Parameters parameters;
-    //-o -i -m 
-    for (int i = 1; i < (argc-1); ++i){
+    //-o -z -i -m -c -s -j -d
+    for (int i = 1; i < argc; ++i){
         p = charArrayToLower(argv[i]);
+        bool has_value = (i + 1) < argc;
         
-        if (strcmp(p, "-o") == 0 || strcmp(p, "-output") == 0){
+        if (strcmp(p, "-j") == 0 || strcmp(p, "-join") == 0){
+            parameters.merge_chains = true;
+        }
+        else if (strcmp(p, "-d") == 0 || strcmp(p, "-dedup") == 0){
+            parameters.remove_duplicates = true;
+        }
+        else if (!has_value) {
+            cout << "Parameter " << p << " wasn't recognized. Try again." << endl;
+        }
+        else if (strcmp(p, "-o") == 0 || strcmp(p, "-output") == 0){
             parameters.output_file = argv[i+1];
             ++i;
         }
+        else if (strcmp(p, "-z") == 0 || strcmp(p, "-compress") == 0){
+            parameters.compression = argv[i+1];
+            ++i;
+        }
         else if (strcmp(p, "-i") == 0 || strcmp(p, "-input") == 0) {
             parameters.input_file =  argv[i+1];
             ++i;
@@ -170,6 +273,14 @@ Parameters parseParameters(int argc, char* argv[]) {
             parameters.mode = argv[i+1];
             ++i;
         }
+        else if (strcmp(p, "-c") == 0 || strcmp(p, "-cache") == 0) {
+            parameters.cache_dir = argv[i+1];
+            ++i;
+        }
+        else if (strcmp(p, "-s") == 0 || strcmp(p, "-sink") == 0) {
+            parameters.sink = argv[i+1];
+            ++i;
+        }
         else {
             cout << "Parameter " << p << " wasn't recognized. Try again." << endl;
         }
@@ -181,8 +292,10 @@ Parameters parseParameters(int argc, char* argv[]) {
 /**
  * Modifica los parámetros para que puedan ser parseados más facilmente en un
  * futuro. Si el fichero de salida esta vacio se le asigna la misma ruta y
- * nombre que el de entrada. Se elimina la extensión del fichero de salida y se
- * pasa el modo a minusculas.
+ * nombre que el de entrada. Si el fichero de salida termina en .gz o .zst y
+ * no se ha indicado la compresión, se comprime con ese formato. Se elimina la
+ * extensión del fichero de salida y se pasan el modo, el destino y la
+ * compresión a minusculas.
  * 
  * @param [in,out]  p   Structura que contiene la información necesaria para ejecutar el programa.
  **/
@@ -191,8 +304,18 @@ void sanitizeParameters(Parameters& p) {
         p.output_file = p.input_file;
     }
     
+    string output = charArrayToLower(p.output_file);
+    if (p.compression == "" && output.size() > 3 && output.compare(output.size() - 3, 3, ".gz") == 0) {
+        p.compression = "gzip";
+    }
+    else if (p.compression == "" && output.size() > 4 && output.compare(output.size() - 4, 4, ".zst") == 0) {
+        p.compression = "zstd";
+    }
+    
     p.output_file = p.output_file.substr(0, p.output_file.find(".", 0));
     p.mode = charArrayToLower(p.mode);
+    p.sink = charArrayToLower(p.sink);
+    p.compression = charArrayToLower(p.compression);
 }
 
 /**
@@ -0,0 +1,67 @@
+#!/bin/bash
+#
+# Mide el tiempo de conversión a .pkje (-m p) de árboles de Purkinje
+# sintéticos en forma de peine, generados con generate_comb.py, en los que
+# cada nodo tiene un hijo de más que hay que separar. Cada conversión se
+# repite varias veces y se muestra el mejor tiempo de CPU (user+sys). Para
+# medir con un solo núcleo se puede ejecutar con "taskset -c 0".
+#
+# Uso: benchmark_purkinje.sh [ejecutable] [nodos ...]
+#      REPEAT=n  número de repeticiones de cada conversión (3 por defecto).
+#      OUT_DIR   directorio de los ficheros generados (uno temporal por defecto).
+#
+# Autor: Víctor Guillermo Andrés Escudero
+# Fecha: 17/10/2026
+#
+
+cd "$(dirname "$0")"
+
+PROGRAM=${1:-../Codigo/build/HeartConverter}
+shift
+REPEAT=${REPEAT:-3}
+SCRIPT_DIR=$(pwd)
+
+if [ ! -x "$PROGRAM" ]; then
+    echo "Executable $PROGRAM not found."
+    exit 1
+fi
+PROGRAM=$(cd "$(dirname "$PROGRAM")" && pwd)/$(basename "$PROGRAM")
+
+if [ $# -gt 0 ]; then
+    SIZES=("$@")
+else
+    SIZES=(5000 20000 80000)
+fi
+
+# El programa corta el nombre de salida en el primer punto, así que el
+# directorio no puede tener puntos
+if [ -z "$OUT_DIR" ]; then
+    OUT_DIR=$(mktemp -d "${TMPDIR:-/tmp}/purkinje_XXXXXX")
+    trap 'rm -rf "$OUT_DIR"' EXIT
+fi
+
+# El fichero de configuración se crea en el directorio de trabajo
+cd "$OUT_DIR"
+
+# Convierte un fichero y muestra el tiempo de CPU en milisegundos.
+#   $1 fichero vtk, $2 nombre de salida
+convert() {
+    local TIMEFORMAT='%3U %3S'
+    { time "$PROGRAM" -i "$1" -o "$2" -m p > /dev/null; } 2>&1 | awk '{ printf "%d\n", ($1 + $2) * 1000 }'
+}
+
+printf "%-10s %10s\n" "nodes" "time"
+
+for size in "${SIZES[@]}"; do
+    input="$OUT_DIR/comb$size.vtk"
+    python3 "$SCRIPT_DIR/generate_comb.py" "$size" "$input"
+
+    best=""
+    for ((i = 0; i < REPEAT; ++i)); do
+        time=$(convert "$input" "$OUT_DIR/comb$size")
+        if [ -z "$best" ] || [ "$time" -lt "$best" ]; then
+            best=$time
+        fi
+    done
+    printf "%-10s %6d.%03ds\n" "$size" $((best / 1000)) $((best % 1000))
+done
@@ -0,0 +1,96 @@
+#!/bin/bash
+#
+# Compara el tiempo de escritura de los distintos destinos de los ficheros de
+# salida (-sink buffer, mmap y uring) convirtiendo los modelos de Tests, u
+# otros ficheros vtk pasados como argumentos. Cada conversión se repite
+# varias veces y se muestra el mejor tiempo. También comprueba que todos los
+# destinos generan exactamente los mismos ficheros.
+#
+# Uso: benchmark_sinks.sh [ejecutable] [fichero.vtk ...]
+#      REPEAT=n  número de repeticiones de cada conversión (5 por defecto).
+#      OUT_DIR   directorio de los ficheros generados (uno temporal por defecto).
+#      COMPRESS  formato de compresión de los ficheros (gzip o zstd), sin comprimir
+#                por defecto.
+#
+# Autor: Víctor Guillermo Andrés Escudero
+# Fecha: 17/10/2026
+#
+
+cd "$(dirname "$0")"
+
+PROGRAM=${1:-../Codigo/build/HeartConverter}
+shift
+REPEAT=${REPEAT:-5}
+SINKS="buffer mmap uring"
+
+if [ ! -x "$PROGRAM" ]; then
+    echo "Executable $PROGRAM not found."
+    exit 1
+fi
+
+if [ $# -gt 0 ]; then
+    INPUTS=("$@")
+else
+    INPUTS=(Tests/Corazon/*/*.vtk Tests/Purkinje/*/*.vtk)
+fi
+
+# El programa corta el nombre de salida en el primer punto, así que el
+# directorio no puede tener puntos
+if [ -z "$OUT_DIR" ]; then
+    OUT_DIR=$(mktemp -d "${TMPDIR:-/tmp}/sinks_XXXXXX")
+    trap 'rm -rf "$OUT_DIR"' EXIT
+fi
+
+for sink in $SINKS; do
+    mkdir -p "$OUT_DIR/$sink"
+done
+
+# Convierte un fichero y muestra el tiempo en nanosegundos.
+#   $1 fichero vtk, $2 modo, $3 destino, $4 nombre de salida
+convert() {
+    local start end
+    start=$(date +%s%N)
+    "$PROGRAM" -i "$1" -o "$4" -m "$2" -s "$3" ${COMPRESS:+-z "$COMPRESS"} > /dev/null
+    end=$(date +%s%N)
+    echo $((end - start))
+}
+
+printf "%-24s %-5s" "file" "mode"
+for sink in $SINKS; do
+    printf " %10s" "$sink"
+done
+printf "\n"
+
+for input in "${INPUTS[@]}"; do
+    name=$(basename "$input" .vtk)
+
+    case "$input" in
+        *Purkinje*) modes="p" ;;
+        *)          modes="h hb" ;;
+    esac
+
+    for mode in $modes; do
+        printf "%-24s %-5s" "$name" "$mode"
+
+        for sink in $SINKS; do
+            best=""
+            for ((i = 0; i < REPEAT; ++i)); do
+                time=$(convert "$input" "$mode" "$sink" "$OUT_DIR/$sink/$name")
+                if [ -z "$best" ] || [ "$time" -lt "$best" ]; then
+                    best=$time
+                fi
+            done
+            printf " %4d.%04ds" $((best / 1000000000)) $((best % 1000000000 / 100000))
+        done
+        printf "\n"
+
+        # Todos los destinos deben generar los mismos ficheros
+        for file in "$OUT_DIR"/buffer/"$name".*; do
+            for sink in $SINKS; do
+                if ! cmp -s "$file" "$OUT_DIR/$sink/$(basename "$file")"; then
+                    echo "  $sink: $(basename "$file") differs from buffer"
+                fi
+            done
+        done
+    done
+done
@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+#
+# Genera un árbol de Purkinje sintético en forma de peine, en formato VTK
+# "legacy" ASCII. El tronco es una cadena de cables y de cada uno de sus
+# nodos salen además dos ramas, así que todos los nodos tienen tres hijos y
+# HeartConverter tiene que separar uno en cada nodo. Como en los árboles de
+# Tests, cada cable usa sus propias copias de los puntos.
+#
+# Uso: generate_comb.py nodos fichero.vtk
+#
+# Autor: Víctor Guillermo Andrés Escudero
+# Fecha: 17/10/2026
+#
+
+import sys
+
+if len(sys.argv) != 3:
+    print("Uso: generate_comb.py nodos fichero.vtk")
+    sys.exit(1)
+
+nodes = int(sys.argv[1])
+output = sys.argv[2]
+
+points = []
+lines = []
+
+
+def add_point(x, y, z):
+    points.append((x, y, z))
+    return len(points) - 1
+
+
+# Cable que llega a la raíz del tronco
+lines.append((add_point(-1, 0, 0), add_point(0, 0, 0)))
+
+for i in range(nodes):
+    lines.append((add_point(i, 0, 0), add_point(i + 1, 0, 0)))
+    for side in (1, -1):
+        lines.append((add_point(i, 0, 0), add_point(i + 0.5, side, 0)))
+
+with open(output, "w") as f:
+    f.write("# vtk DataFile Version 3.0\ncomb\nASCII\nDATASET POLYDATA\n")
+    f.write("POINTS %d float\n" % len(points))
+    for point in points:
+        f.write("%g %g %g\n" % point)
+    f.write("LINES %d %d\n" % (len(lines), 3 * len(lines)))
+    for begin, end in lines:
+        f.write("2 %d %d\n" % (begin, end))